@@ -0,0 +1,224 @@
+/*
+Copyright (c) 2022, COSIC-KU Leuven, Kasteelpark Arenberg 10, bus 2452, B-3001 Leuven-Heverlee, Belgium.
+
+All rights reserved
+*/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "arith.h"
+
+/**
+ * Additive FFT over GF(2^k), in the novel polynomial basis of Lin, Chung and Han
+ *  ("Novel Polynomial Basis and Its Application to Reed-Solomon Erasure Codes", FOCS 2014)
+ *
+ * Points are indexed by integers: point(p) = sum of basis[b] for every bit b set in p.
+ * With the basis (1, 2, 4, ...), that is exactly how the protocols encode the evaluation points (1, ..., N);
+ *  with the lifts of that basis into an extension field, it matches their lifted points.
+ * A transform of size 2^m works on the affine subspace {point(shift ^ i) | i < 2^m}, for a shift that is a multiple of 2^m.
+ *
+ * The novel basis polynomial X_i is the product of the Ŵ_j for the bits j set in i, so it has degree i.
+ * Ŵ_j is the vanishing polynomial of span(basis[0], ..., basis[j-1]), normalized to 1 in basis[j].
+ */
+template <int k>
+class AdditiveFFT {
+    public:
+        explicit AdditiveFFT(const std::vector<GF2k<k>>& basis) : m_basis(basis) {
+            const int dim = basis.size();
+            // Unnormalized W_j in all basis elements, using W_j(x) = W_{j-1}(x) * (W_{j-1}(x) + W_{j-1}(basis[j-1]))
+            std::vector<GF2k<k>> w(basis);
+            // Coefficients of the linearized polynomial W_j, of x^(2^i)
+            std::vector<GF2k<k>> coeffs{GF2k<k>(1)};
+            for (int j = 0; j < dim; j++) {
+                GF2k<k> norm = w[j].inv();
+                m_twiddles.emplace_back(dim, GF2k<k>(0));
+                for (int b = j; b < dim; b++) m_twiddles[j][b] = w[b] * norm;
+                m_vanishing.emplace_back(coeffs);
+                for (auto& c : m_vanishing[j]) c *= norm;
+
+                // W_{j+1} = W_j^2 + W_j(basis[j]) * W_j, squaring shifts the linearized coefficients
+                GF2k<k> at_basis = w[j];
+                for (int b = 0; b < dim; b++) w[b] *= w[b] + at_basis;
+                std::vector<GF2k<k>> next(j + 2, GF2k<k>(0));
+                for (int i = 0; i <= j; i++) {
+                    next[i + 1] += coeffs[i].square();
+                    next[i] += at_basis * coeffs[i];
+                }
+                coeffs = std::move(next);
+            }
+        }
+
+        int dimension() const { return m_basis.size(); }
+
+        GF2k<k> point(std::uint64_t p) const {
+            assert(p >> dimension() == 0);
+            GF2k<k> res(0);
+            for (int b = 0; p != 0; b++, p >>= 1) {
+                if (p & 1) res += m_basis[b];
+            }
+            return res;
+        }
+
+        /**
+         * Evaluate the polynomial with the 2^m novel basis coefficients `a` in point(shift ^ i), for all i < 2^m, in place
+         */
+        void fft(GF2k<k>* a, int m, std::uint64_t shift = 0) const {
+            check_subspace(m, shift);
+            for (int r = m - 1; r >= 0; r--) {
+                std::size_t half = std::size_t(1) << r;
+                for (std::size_t c = 0; c < (std::size_t(1) << m); c += 2 * half) {
+                    GF2k<k> s = twiddle(r, shift ^ c);
+                    if (s != GF2k<k>(0)) scaled_add(a + c, s, a + c + half, half);
+                    for (std::size_t i = c; i < c + half; i++) a[i + half] += a[i];
+                }
+            }
+        }
+
+        /**
+         * Inverse of fft: from the values in point(shift ^ i) to the 2^m novel basis coefficients, in place
+         */
+        void ifft(GF2k<k>* a, int m, std::uint64_t shift = 0) const {
+            check_subspace(m, shift);
+            for (int r = 0; r < m; r++) {
+                std::size_t half = std::size_t(1) << r;
+                for (std::size_t c = 0; c < (std::size_t(1) << m); c += 2 * half) {
+                    GF2k<k> s = twiddle(r, shift ^ c);
+                    for (std::size_t i = c; i < c + half; i++) a[i + half] += a[i];
+                    if (s != GF2k<k>(0)) scaled_add(a + c, s, a + c + half, half);
+                }
+            }
+        }
+
+        /**
+         * Convert the 2^m monomial coefficients in `a` to novel basis coefficients, in place
+         *
+         * Recursively divides by Ŵ_{m-1}: f = r + q * Ŵ_{m-1} and X_{i + 2^(m-1)} = X_i * Ŵ_{m-1}
+         * Ŵ_{m-1} only has m non-zero coefficients, so this takes O(2^m * m^2)
+         */
+        void to_novel(GF2k<k>* a, int m) const {
+            assert(m <= dimension());
+            if (m == 0) return;
+            int r = m - 1;
+            std::size_t half = std::size_t(1) << r;
+            const auto& w = m_vanishing[r];
+            GF2k<k> lead_inv = w[r].inv();
+            for (std::size_t d = 2 * half - 1; d >= half; d--) {
+                GF2k<k> q = a[d] * lead_inv;
+                a[d] = q;
+                for (int i = 0; i < r; i++) a[d - half + (std::size_t(1) << i)] -= q * w[i];
+            }
+            to_novel(a, r);
+            to_novel(a + half, r);
+        }
+
+        /**
+         * Inverse of to_novel
+         */
+        void from_novel(GF2k<k>* a, int m) const {
+            assert(m <= dimension());
+            if (m == 0) return;
+            int r = m - 1;
+            std::size_t half = std::size_t(1) << r;
+            from_novel(a, r);
+            from_novel(a + half, r);
+            const auto& w = m_vanishing[r];
+            for (std::size_t d = half; d < 2 * half; d++) {
+                GF2k<k> q = a[d];
+                for (int i = 0; i < r; i++) a[d - half + (std::size_t(1) << i)] += q * w[i];
+                a[d] = q * w[r];
+            }
+        }
+
+        /**
+         * Evaluate the degree D polynomial `message` (monomial coefficients) in point(1), ..., point(N)
+         */
+        template <int D, std::size_t N>
+        std::array<GF2k<k>, N> encode(const std::array<GF2k<k>, D + 1>& message) const {
+            int m = log2_ceil(N + 1);
+            std::vector<GF2k<k>> a(std::size_t(1) << m, GF2k<k>(0));
+            std::copy(message.begin(), message.end(), a.begin());
+            // The degree stays below 2^log2_ceil(D + 1) in the novel basis
+            to_novel(a.data(), log2_ceil(D + 1));
+            fft(a.data(), m);
+            std::array<GF2k<k>, N> res;
+            std::copy(a.begin() + 1, a.begin() + 1 + N, res.begin());
+            return res;
+        }
+
+        static int log2_ceil(std::size_t n) {
+            int m = 0;
+            while ((std::size_t(1) << m) < n) m++;
+            return m;
+        }
+
+    private:
+        void check_subspace(int m, std::uint64_t shift) const {
+            assert(m <= dimension());
+            assert(shift >> dimension() == 0);
+            assert((shift & ((std::uint64_t(1) << m) - 1)) == 0);
+            (void) m;
+            (void) shift;
+        }
+
+        // out += s * x, with the vectorized kernel once the blocks are large enough to amortize a call
+        static void scaled_add(GF2k<k>* out, const GF2k<k>& s, const GF2k<k>* x, std::size_t n) {
+            if (n >= 16) {
+                batch::axpy(out, s, x, n);
+            } else {
+                for (std::size_t i = 0; i < n; i++) out[i] += s * x[i];
+            }
+        }
+
+        // Ŵ_r(point(p)); Ŵ_r is GF(2)-linear and vanishes on the first r basis elements
+        GF2k<k> twiddle(int r, std::uint64_t p) const {
+            GF2k<k> res(0);
+            p >>= r;
+            for (int b = r; p != 0; b++, p >>= 1) {
+                if (p & 1) res += m_twiddles[r][b];
+            }
+            return res;
+        }
+
+        std::vector<GF2k<k>> m_basis;
+        // m_twiddles[r][b] = Ŵ_r(basis[b])
+        std::vector<std::vector<GF2k<k>>> m_twiddles;
+        // m_vanishing[r][i] is the coefficient of x^(2^i) in Ŵ_r
+        std::vector<std::vector<GF2k<k>>> m_vanishing;
+};
+
+namespace detail {
+    // Large enough for any committee or batch, small enough to keep the tables tiny
+    constexpr int MAX_FFT_DIMENSION = 32;
+} // namespace detail
+
+/**
+ * The additive FFT on the points (0, 1, 2, ...), with basis (1, 2, 4, ...)
+ */
+template <int k>
+const AdditiveFFT<k>& additive_fft() {
+    static const AdditiveFFT<k> fft([]() {
+        std::vector<GF2k<k>> basis;
+        for (int b = 0; b < std::min(k, detail::MAX_FFT_DIMENSION); b++) basis.emplace_back(1ll << b);
+        return basis;
+    }());
+    return fft;
+}
+
+/**
+ * The additive FFT on the points (0, 1, 2, ...) of GF(2^k2), lifted into GF(2^k)
+ */
+template <int k2, int k>
+const AdditiveFFT<k>& lifted_additive_fft() {
+    static const AdditiveFFT<k> fft([]() {
+        std::vector<GF2k<k>> basis;
+        for (int b = 0; b < std::min(k2, detail::MAX_FFT_DIMENSION); b++) basis.push_back(liftGF<k>(GF2k<k2>(1ll << b)));
+        return basis;
+    }());
+    return fft;
+}
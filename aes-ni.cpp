@@ -7,6 +7,8 @@ All rights reserved
 
 #include "aes.h"
 
+#include <immintrin.h>
+
 /**********************
  *    M-Code Version  *
  **********************/
@@ -230,3 +232,51 @@ void aes_256_encrypt(uint8_t *out, const uint8_t *in, const uint8_t *key)
   tmp= _mm_aesenclast_si128(tmp, ((__m128i *) key)[j]);
   _mm_storeu_si128(&((__m128i *) out)[0], tmp);
 }
+
+/**********************
+ *   VAES Versions    *
+ **********************/
+
+#pragma GCC push_options
+#pragma GCC target("avx2,vaes")
+__attribute__((optimize("unroll-loops"))) void ecb_aes_128_encrypt_vaes256(
+    uint8_t *out, const uint8_t *in, const uint8_t *key, int nblocks)
+{
+  __m256i rk[11];
+  for (int j= 0; j < 11; j++)
+    rk[j]= _mm256_broadcastsi128_si256(_mm_load_si128((__m128i *) key + j));
+  for (int i= 0; i < nblocks; i+= 2)
+    {
+      __m256i tmp= _mm256_loadu_si256((__m256i *) (in + i * AES_BLK_SIZE));
+      tmp= _mm256_xor_si256(tmp, rk[0]);
+      for (int j= 1; j < 10; j++)
+        tmp= _mm256_aesenc_epi128(tmp, rk[j]);
+      tmp= _mm256_aesenclast_epi128(tmp, rk[10]);
+      _mm256_storeu_si256((__m256i *) (out + i * AES_BLK_SIZE), tmp);
+    }
+}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,vaes")
+// _mm512_broadcast_i32x4 starts from an undefined vector, which GCC reports as uninitialized
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+__attribute__((optimize("unroll-loops"))) void ecb_aes_128_encrypt_vaes512(
+    uint8_t *out, const uint8_t *in, const uint8_t *key, int nblocks)
+{
+  __m512i rk[11];
+  for (int j= 0; j < 11; j++)
+    rk[j]= _mm512_broadcast_i32x4(_mm_load_si128((__m128i *) key + j));
+  for (int i= 0; i < nblocks; i+= 4)
+    {
+      __m512i tmp= _mm512_loadu_si512(in + i * AES_BLK_SIZE);
+      tmp= _mm512_xor_si512(tmp, rk[0]);
+      for (int j= 1; j < 10; j++)
+        tmp= _mm512_aesenc_epi128(tmp, rk[j]);
+      tmp= _mm512_aesenclast_epi128(tmp, rk[10]);
+      _mm512_storeu_si512(out + i * AES_BLK_SIZE, tmp);
+    }
+}
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
@@ -97,6 +97,18 @@ inline void ecb_aes_128_encrypt(__m128i *out, const __m128i *in,
     out[indices[i]]= tmp[i];
 }
 
+/*********** VAES Versions ***********/
+/* Same as ecb_aes_128_encrypt, on several blocks per instruction, for the key
+ * schedule produced by the M-Code version. Only call these after checking
+ * cpu_has_vaes() (and the matching vector extension) at runtime.
+ *   - nblocks must be a multiple of 2 (vaes256) or 4 (vaes512)
+ *   - in and out need not be aligned
+ */
+void ecb_aes_128_encrypt_vaes256(uint8_t *out, const uint8_t *in,
+                                 const uint8_t *key, int nblocks);
+void ecb_aes_128_encrypt_vaes512(uint8_t *out, const uint8_t *in,
+                                 const uint8_t *key, int nblocks);
+
 inline void aes_encrypt(uint8_t *C, const uint8_t *M, const uint8_t *RK)
 {
   aes_128_encrypt(C, M, RK);
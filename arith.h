@@ -9,11 +9,15 @@ All rights reserved
 #include <iostream>
 #include <iomanip>
 #include <tuple>
+#include <vector>
 
 #include <emmintrin.h>
+#include <immintrin.h>
 #include <smmintrin.h>
 #include <wmmintrin.h>
 
+#include "dispatch.h"
+#include "gflogtables.h"
 #include "gftables.h"
 #include "random.h"
 
@@ -134,6 +138,7 @@ namespace detail {
 
     class int256 {
         public:
+            int256() : m_lo(), m_hi() {}
             int256(int128 lo, int128 hi) : m_lo(lo), m_hi(hi) {}
 
             int256 operator&(const int256& o) const {
@@ -146,14 +151,19 @@ namespace detail {
             int256 operator^(const int256& o) const {
                 return int256(m_lo ^ o.m_lo, m_hi ^ o.m_hi);
             }
+            int256& operator^=(const int256& o) {
+                return *this = *this ^ o;
+            }
 
             int256 operator>>(int s) const {
-                assert(s < 128);
+                assert(s <= 256);
+                if (s >= 128) return int256(m_hi >> (s - 128), 0);
                 int128 lo = (m_lo >> s) ^ (m_hi << (128 - s));
                 return int256(lo, m_hi >> s);
             }
             int256 operator<<(int s) const {
-                assert(s < 128);
+                assert(s <= 256);
+                if (s >= 128) return int256(0, m_lo << (s - 128));
                 int128 hi = (m_hi << s) ^ (m_lo >> (128 - s));
                 return int256(m_lo << s, hi);
             }
@@ -195,7 +205,11 @@ namespace detail {
         if constexpr(std::is_same_v<T, int128> || std::is_same_v<T, int256>) {
             return T::make_mask(k);
         } else {
-            return (T(1) << (k % (8 * sizeof(T)))) - 1;
+            if constexpr(k >= 8 * sizeof(T)) { // Shifting by the full width is undefined
+                return ~T(0);
+            } else {
+                return (T(1) << k) - 1;
+            }
         }
     }
 
@@ -233,6 +247,15 @@ namespace detail {
         return reduction_polynomial_impl<k, num_reduction_monomials<k>()>::value();
     }
 
+    template <int k>
+    constexpr int max_reduction_shift() {
+        if constexpr(num_reduction_monomials<k>() == 3) {
+            return reduction_polynomial<k>();
+        } else {
+            return std::get<2>(reduction_polynomial<k>());
+        }
+    }
+
     template <int k>
     int256 initial_mult(int128 a_, int128 b_) {
         __m128i a = a_.reveal();
@@ -252,6 +275,17 @@ namespace detail {
         return int256(x0, x1);
     }
 
+    // Squaring is linear over GF(2): the cross terms cancel, so only the words multiplied with themselves remain
+    template <int k>
+    int256 initial_square(int128 a_) {
+        __m128i a = a_.reveal();
+        if constexpr(k > 64) {
+            return int256(_mm_clmulepi64_si128(a, a, 0x00), _mm_clmulepi64_si128(a, a, 0x11));
+        } else {
+            return int256(_mm_clmulepi64_si128(a, a, 0x00), int128());
+        }
+    }
+
     template <int k, typename T>
     T reduce_once(const T& x, int red) { // Trinomial
         T hi = x >> k;
@@ -264,8 +298,10 @@ namespace detail {
         return (x & make_mask<T, k>()) ^ hi ^ (hi << std::get<0>(red)) ^ (hi << std::get<1>(red)) ^ (hi << std::get<2>(red));
     }
 
+    // Straightforward reduction by applying x^k = x^r + 1 (or the pentanomial equivalent) twice,
+    // kept as a reference for the specialized version below
     template <int k, typename T>
-    T reduce(const int256& x) {
+    T reduce_generic(const int256& x) {
         constexpr auto red = reduction_polynomial<k>();
         if constexpr(k <= 32) { // Do everything in a smaller size
             std::uint64_t y = reduce_once<k, std::uint64_t>(x.low().low(), red);
@@ -279,6 +315,51 @@ namespace detail {
         }
     }
 
+    // Write p = L + x^k H, and x^k = 1 + \sum_s x^s. The part of \sum_s x^s H that spills over x^k again
+    // is x^k U with U = \sum_s H >> (k - s), and as long as 2 max_s - 2 < k, (1 + \sum_s x^s) U
+    // stays below x^k. Hence a single fold with T = H + U suffices: p = L + T + \sum_s x^s T (mod x^k)
+    template <int k>
+    constexpr bool single_fold_reduction() {
+        return 2 * max_reduction_shift<k>() - 2 < k;
+    }
+
+    template <int k, typename W>
+    W fold_reduce(const W& lo, const W& hi) {
+        constexpr auto red = reduction_polynomial<k>();
+        if constexpr(num_reduction_monomials<k>() == 3) {
+            W t = hi ^ (hi >> (k - red));
+            return (lo ^ t ^ (t << red)) & make_mask<W, k>();
+        } else {
+            constexpr int a = std::get<0>(red), b = std::get<1>(red), c = std::get<2>(red);
+            W t = hi ^ (hi >> (k - a)) ^ (hi >> (k - b)) ^ (hi >> (k - c));
+            return (lo ^ t ^ (t << a) ^ (t << b) ^ (t << c)) & make_mask<W, k>();
+        }
+    }
+
+    /**
+     * Reduce a product of two field elements (degree at most 2k - 2) modulo the field polynomial
+     *
+     * Only the words that can be nonzero for the given k are touched, and the high part is folded back once
+     */
+    template <int k, typename T>
+    T reduce(const int256& x) {
+        if constexpr(!single_fold_reduction<k>()) {
+            return reduce_generic<k, T>(x);
+        } else if constexpr(k <= 32) { // Everything fits in a single word
+            std::uint64_t p = x.low().low();
+            return fold_reduce<k, std::uint64_t>(p, p >> k);
+        } else if constexpr(k < 64) {
+            std::uint64_t lo = x.low().low(), hi = x.low().high();
+            return fold_reduce<k, std::uint64_t>(lo, (lo >> k) ^ (hi << (64 - k)));
+        } else if constexpr(k == 64) {
+            return fold_reduce<k, std::uint64_t>(x.low().low(), x.low().high());
+        } else if constexpr(k < 128) {
+            return fold_reduce<k, int128>(x.low(), (x.low() >> k) ^ (x.high() << (128 - k)));
+        } else {
+            return fold_reduce<k, int128>(x.low(), x.high());
+        }
+    }
+
     template <typename T>
     T random(PRNG& gen) {
         T res;
@@ -337,6 +418,129 @@ namespace detail {
                 return Self(table[1<<k][m_val], true);
             }
 
+            Self square() const {
+                return Self(table[m_val][m_val], true);
+            }
+
+            // x^(2^j)
+            Self frobenius(int j) const {
+                F res = m_val;
+                for (int i = 0; i < j % k; i++) res = table[res][res];
+                return Self(res, true);
+            }
+
+            Self pow(std::uint64_t e) const {
+                F res = 1;
+                for (int i = 63 - __builtin_clzll(e | 1); i >= 0; i--) {
+                    res = table[res][res];
+                    if ((e >> i) & 1) res = table[res][m_val];
+                }
+                return Self(res, true);
+            }
+
+            bool operator==(const Base& other) const {
+                return m_val == other.m_val;
+            }
+
+            bool operator!=(const Base& other) const {
+                return m_val != other.m_val;
+            }
+
+            std::array<bool, k> to_bits() const {
+                std::array<bool, k> res;
+                F a = m_val;
+                for (int i = 0; i < k; i++) {
+                    res[i] = a & 1;
+                    a >>= 1;
+                }
+                return res;
+            }
+
+            static Self from_bits(const std::array<bool, k>& bits) {
+                F a = 0;
+                for (int i = 0; i < k; i++) {
+                    a |= F(bits[i]) << i;
+                }
+                return Self(a, true);
+            }
+
+            /**
+             * To be used only when needing access to the underlying bits, really
+             */
+            F force_int() const {
+                return m_val;
+            }
+
+        private:
+            F m_val;
+    };
+
+    // Medium sized fields: multiplication through discrete logarithms, to avoid (1<<k) x (1<<k) tables
+    template <int k, const std::uint16_t log_table[1<<k], const std::uint16_t exp_table[2 * ((1<<k) - 1)], typename Self>
+    class LogGF2k {
+        public:
+            using F = typename datatype<detail::type_idx<k>()>::type;
+            using Base = LogGF2k<k, log_table, exp_table, Self>;
+        private:
+            static constexpr int ORDER = (1<<k) - 1;
+
+            explicit LogGF2k<k, log_table, exp_table, Self>(F f, bool /* skip mask */) : m_val(std::move(f)) {}
+            friend Self;
+
+        public:
+
+            LogGF2k<k, log_table, exp_table, Self>(const std::int64_t& el) : m_val(F(el) & detail::make_mask<F, k>()) {}
+            LogGF2k<k, log_table, exp_table, Self>() : m_val(0) {}
+
+            static Self random(PRNG& gen) {
+                return Self(detail::random<F>(gen));
+            }
+
+            Self operator+(const Base& other) const {
+                return Self(m_val ^ other.m_val, true);
+            }
+            Base& operator+=(const Base& other) {
+                return *this = (*this) + other;
+            }
+
+            Self operator-(const Base& other) const {
+                return Self(m_val ^ other.m_val, true);
+            }
+            Base& operator-=(const Base& other) {
+                return *this = (*this) - other;
+            }
+
+            Self operator*(const Base& other) const {
+                if (m_val == 0 || other.m_val == 0) return Self(0, true);
+                return Self(exp_table[log_table[m_val] + log_table[other.m_val]], true);
+            }
+            Base& operator*=(const Base& other) {
+                return *this = (*this) * other;
+            }
+
+            // Like the small fields, maps 0 to 0
+            Self inv() const {
+                if (m_val == 0) return Self(0, true);
+                return Self(exp_table[ORDER - log_table[m_val]], true);
+            }
+
+            Self square() const {
+                if (m_val == 0) return Self(0, true);
+                return Self(exp_table[2 * log_table[m_val]], true);
+            }
+
+            // x^(2^j)
+            Self frobenius(int j) const {
+                if (m_val == 0) return Self(0, true);
+                return Self(exp_table[(std::uint64_t(log_table[m_val]) << (j % k)) % ORDER], true);
+            }
+
+            Self pow(std::uint64_t e) const {
+                if (e == 0) return Self(1, true);
+                if (m_val == 0) return Self(0, true);
+                return Self(exp_table[(log_table[m_val] * (e % ORDER)) % ORDER], true);
+            }
+
             bool operator==(const Base& other) const {
                 return m_val == other.m_val;
             }
@@ -381,13 +585,14 @@ class GF2k {
         using F = typename detail::datatype<detail::type_idx<k>()>::type;
     private:
         static_assert(2 <= k && k <= 128, "Unsupported extension field");
-        static inline F MASK = detail::make_mask<F, k>();
 
         explicit GF2k<k>(F f, bool /*skip mask*/) : m_val(std::move(f)) {}
 
     public:
+        // Not a static member: for int128 that would be dynamically initialized, in no particular order
+        // with respect to other globals (such as the lifting tables) that are constructed from a GF2k<k>
         template <typename T>
-        explicit GF2k<k>(const T& el) : m_val(F(el) & MASK) {}
+        explicit GF2k<k>(const T& el) : m_val(F(el) & detail::make_mask<F, k>()) {}
         GF2k<k>() : m_val(0) {}
 
         static GF2k<k> random(PRNG& gen) {
@@ -417,20 +622,47 @@ class GF2k {
             return *this = (*this) * other;
         }
 
-        GF2k<k> inv() const {
-            // Probably not the optimal way to compute multiplicative inverses
-            // Ignores the case x = 0
-            // x^(2^K - 2) = x^-1
-            // 2^K - 2 = 0b11...10 => x^(2^K - 2) = (x^2)^(0b11...1)
+        // Squaring is linear, so it's cheaper than a general multiplication
+        GF2k<k> square() const {
+            return GF2k<k>(detail::extract<F>(detail::reduce<k, F>(detail::initial_square<k>(m_val))), true);
+        }
+
+        // x^(2^j)
+        GF2k<k> frobenius(int j) const {
+            GF2k<k> res = *this;
+            for (int i = 0; i < j % k; i++) res = res.square();
+            return res;
+        }
+
+        GF2k<k> pow(std::uint64_t e) const {
             GF2k<k> res(1);
-            GF2k<k> x = (*this) * (*this);
-            for (int i = 0; i < k - 1; i++) {
-                res *= x;
-                x *= x;
+            for (int i = 63 - __builtin_clzll(e | 1); i >= 0; i--) {
+                res = res.square();
+                if ((e >> i) & 1) res *= *this;
             }
             return res;
         }
 
+        GF2k<k> inv() const {
+            // Itoh-Tsujii: x^-1 = x^(2^k - 2) = (b_{k-1})^2 with b_m = x^(2^m - 1)
+            // Walk the binary expansion of k - 1 from the top, using
+            //   b_{2m} = (b_m)^(2^m) * b_m   and   b_{m+1} = (b_m)^2 * x
+            // so that we only need about log2(k) multiplications, and k - 1 (cheap) squarings
+            // Ignores the case x = 0
+            constexpr int top_bit = 31 - __builtin_clz(k - 1);
+            GF2k<k> b = *this;
+            int m = 1;
+            for (int bit = top_bit - 1; bit >= 0; bit--) {
+                b = b.frobenius(m) * b;
+                m *= 2;
+                if (((k - 1) >> bit) & 1) {
+                    b = b.square() * (*this);
+                    m += 1;
+                }
+            }
+            return b.square();
+        }
+
         bool operator==(const GF2k<k>& other) const {
             return m_val == other.m_val;
         }
@@ -504,19 +736,558 @@ SMALLFIELD(8);
 
 #undef SMALLFIELD
 
+#define LOGFIELD(k) \
+    template <> \
+    class GF2k< k > : public detail::LogGF2k< k, gflogtables::log##k, gflogtables::exp##k, GF2k< k >> { \
+        using detail::LogGF2k< k, gflogtables::log##k, gflogtables::exp##k, GF2k< k >>::LogGF2k; \
+    }
+
+LOGFIELD(9);
+LOGFIELD(10);
+LOGFIELD(11);
+LOGFIELD(12);
+LOGFIELD(13);
+LOGFIELD(14);
+LOGFIELD(15);
+LOGFIELD(16);
+
+#undef LOGFIELD
+
 
 // Include here to have all GF2k<k> defined already and avoid circularity
 #include "gflifttables.h"
 
+namespace detail {
+    // Lifting is GF(2)-linear, so tabulate it per byte of the input: lift_table<k, k2>()[i][b] lifts b << (8*i)
+    // Built on first use, since the lifting vectors themselves are dynamically initialized
+    template <int k, int k2>
+    const auto& lift_table() {
+        constexpr int bytes = (k + 7) / 8;
+        constexpr int width = 1 << std::min(k, 8);
+        static const auto table = [] {
+            std::array<std::array<GF2k<k2>, width>, bytes> res;
+            for (int i = 0; i < bytes; i++) {
+                res[i][0] = GF2k<k2>(0);
+                for (int bit = 0; bit < std::min(8, k - 8 * i); bit++) {
+                    for (int v = 1 << bit; v < (2 << bit); v++) {
+                        res[i][v] = res[i][v - (1 << bit)] + gflifttables::lift_v<k, k2>[8 * i + bit];
+                    }
+                }
+            }
+            return res;
+        }();
+        return table;
+    }
+} // namespace detail
+
 template <int k2, int k>
 GF2k<k2> liftGF(const GF2k<k>& base) {
     static_assert(k2 % k == 0, "No subfield of correct size exists");
-    auto b = base.force_int();
-    GF2k<k2> res(b & 1);
-    for (int i = 1; i < k; i++) {
-        b >>= 1;
-        if (b & 1) res += gflifttables::lift_v<k, k2>[i];
+    static_assert(k <= 64, "Lifting from large fields is not supported");
+    const auto& table = detail::lift_table<k, k2>();
+    std::uint64_t b = base.force_int();
+    GF2k<k2> res = table[0][b & 0xff];
+    for (std::size_t i = 1; i < table.size(); i++) {
+        res += table[i][(b >> (8 * i)) & 0xff];
     }
     return res;
 }
 
+
+
+namespace detail {
+    // Whether GF2k<k> is implemented with lookup tables, rather than with carryless multiplication
+    template <int k>
+    constexpr bool is_table_based() {
+        return k <= 16;
+    }
+} // namespace detail
+
+/**
+ * Accumulator for sums of products \sum_i a_i * b_i
+ *
+ * Since addition is just XOR, the unreduced products can be added up directly,
+ * and the reduction modulo the field polynomial only has to happen once, when reading out the result.
+ */
+template <int k>
+class GF2kAccumulator {
+    private:
+        // The product of two elements fits in 128 bits for k <= 64
+        using Acc = std::conditional_t<detail::is_table_based<k>(), GF2k<k>,
+              std::conditional_t<(k <= 64), detail::int128, detail::int256>>;
+
+    public:
+        GF2kAccumulator() : m_acc() {}
+
+        void add_product(const GF2k<k>& a, const GF2k<k>& b) {
+            if constexpr(detail::is_table_based<k>()) {
+                m_acc += a * b;
+            } else if constexpr(k <= 64) {
+                m_acc ^= detail::initial_mult<k>(a.force_int(), b.force_int()).low();
+            } else {
+                m_acc ^= detail::initial_mult<k>(a.force_int(), b.force_int());
+            }
+        }
+
+        void add(const GF2k<k>& a) {
+            if constexpr(detail::is_table_based<k>()) {
+                m_acc += a;
+            } else if constexpr(k <= 64) {
+                m_acc ^= detail::int128(a.force_int());
+            } else {
+                m_acc ^= detail::int256(a.force_int(), 0);
+            }
+        }
+
+        GF2kAccumulator<k>& operator+=(const GF2kAccumulator<k>& other) {
+            if constexpr(detail::is_table_based<k>()) {
+                m_acc += other.m_acc;
+            } else {
+                m_acc ^= other.m_acc;
+            }
+            return *this;
+        }
+
+        GF2k<k> reduce() const {
+            using F = typename GF2k<k>::F;
+            if constexpr(detail::is_table_based<k>()) {
+                return m_acc;
+            } else if constexpr(k <= 64) {
+                return GF2k<k>(detail::extract<F>(detail::reduce<k, F>(detail::int256(m_acc, 0))));
+            } else {
+                return GF2k<k>(detail::extract<F>(detail::reduce<k, F>(m_acc)));
+            }
+        }
+
+    private:
+        Acc m_acc;
+};
+
+/****** Batched arithmetic ******/
+
+namespace detail {
+    // The vectorized kernels reduce every 128-bit lane on its own, with a single fold
+    template <int k>
+    constexpr bool has_wide_kernels() {
+        return 64 < k && k < 128 && single_fold_reduction<k>();
+    }
+
+} // namespace detail
+
+// Everything in here is only ever called after checking for support at runtime
+#pragma GCC push_options
+#pragma GCC target("avx2,vpclmulqdq")
+// The intrinsics start from undefined vectors, which GCC reports as (maybe) uninitialized
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+namespace detail::avx2 {
+    // Shift each 128-bit lane left by s < 64 bits
+    template <int s>
+    inline __m256i lane_shl(__m256i x) {
+        if constexpr(s == 0) {
+            return x;
+        } else {
+            return _mm256_slli_epi64(x, s) ^ _mm256_srli_epi64(_mm256_unpacklo_epi64(_mm256_setzero_si256(), x), 64 - s);
+        }
+    }
+
+    // Shift each 128-bit lane right by 0 < s < 128 bits
+    template <int s>
+    inline __m256i lane_shr(__m256i x) {
+        __m256i high_word = _mm256_unpackhi_epi64(x, _mm256_setzero_si256());
+        if constexpr(s < 64) {
+            return _mm256_srli_epi64(x, s) ^ _mm256_slli_epi64(high_word, 64 - s);
+        } else {
+            return _mm256_srli_epi64(high_word, s - 64);
+        }
+    }
+
+    // Same as `fold_reduce`, without the final mask
+    template <int k>
+    inline __m256i fold(__m256i hi) {
+        constexpr auto red = reduction_polynomial<k>();
+        if constexpr(num_reduction_monomials<k>() == 3) {
+            __m256i t = hi ^ lane_shr<k - red>(hi);
+            return t ^ lane_shl<red>(t);
+        } else {
+            constexpr int a = std::get<0>(red), b = std::get<1>(red), c = std::get<2>(red);
+            __m256i t = hi ^ lane_shr<k - a>(hi) ^ lane_shr<k - b>(hi) ^ lane_shr<k - c>(hi);
+            return t ^ lane_shl<a>(t) ^ lane_shl<b>(t) ^ lane_shl<c>(t);
+        }
+    }
+
+    // Same as `initial_mult`, for two elements at once
+    inline void product(__m256i a, __m256i b, __m256i& lo, __m256i& hi) {
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i mid = _mm256_clmulepi64_epi128(a, b, 0x01) ^ _mm256_clmulepi64_epi128(a, b, 0x10);
+        lo = _mm256_clmulepi64_epi128(a, b, 0x00) ^ _mm256_unpacklo_epi64(zero, mid);
+        hi = _mm256_clmulepi64_epi128(a, b, 0x11) ^ _mm256_unpackhi_epi64(mid, zero);
+    }
+
+    // Same as `reduce`, for two elements at once
+    template <int k>
+    inline __m256i reduce(__m256i lo, __m256i hi) {
+        constexpr int s = k - 64;
+        const __m256i mask = _mm256_set_epi64x((1ll << s) - 1, -1, (1ll << s) - 1, -1);
+        // (hi:lo) >> k, folded back in once
+        __m256i top = _mm256_srli_epi64(_mm256_alignr_epi8(hi, lo, 8), s) ^ _mm256_slli_epi64(hi, 64 - s);
+        return (lo ^ fold<k>(top)) & mask;
+    }
+
+    template <int k>
+    inline __m256i mul(__m256i a, __m256i b) {
+        __m256i lo, hi;
+        product(a, b, lo, hi);
+        return reduce<k>(lo, hi);
+    }
+
+    template <int k>
+    void mul_n(GF2k<k>* out, const GF2k<k>* a, const GF2k<k>* b, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), mul<k>(x, y));
+        }
+        for (; i < n; i++) out[i] = a[i] * b[i];
+    }
+
+    template <int k>
+    void mul_acc_n(GF2k<k>* out, const GF2k<k>* a, const GF2k<k>* b, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            __m256i z = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), z ^ mul<k>(x, y));
+        }
+        for (; i < n; i++) out[i] += a[i] * b[i];
+    }
+
+    // out[i] = a * x[i], or out[i] += a * x[i] when `accumulate`
+    template <int k, bool accumulate>
+    void scale_n(GF2k<k>* out, const GF2k<k>& a, const GF2k<k>* x, std::size_t n) {
+        const __m256i y = _mm256_broadcastsi128_si256(a.force_int().reveal());
+        std::size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m256i prod = mul<k>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)), y);
+            if constexpr(accumulate) prod ^= _mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), prod);
+        }
+        for (; i < n; i++) {
+            if constexpr(accumulate) out[i] += a * x[i]; else out[i] = a * x[i];
+        }
+    }
+
+    template <int k>
+    GF2k<k> dot_n(const GF2k<k>* a, const GF2k<k>* b, std::size_t n) {
+        // Accumulate the unreduced products, and only reduce once at the end
+        __m256i acc_lo = _mm256_setzero_si256(), acc_hi = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            __m256i lo, hi;
+            product(x, y, lo, hi);
+            acc_lo ^= lo;
+            acc_hi ^= hi;
+        }
+        __m256i acc = reduce<k>(acc_lo, acc_hi);
+        GF2k<k> res(int128(_mm256_castsi256_si128(acc) ^ _mm256_extracti128_si256(acc, 1)));
+        for (; i < n; i++) res += a[i] * b[i];
+        return res;
+    }
+} // namespace detail::avx2
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,vpclmulqdq")
+// The intrinsics start from undefined vectors, which GCC reports as (maybe) uninitialized
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+namespace detail::avx512 {
+    // Shift each 128-bit lane left by s < 64 bits
+    template <int s>
+    inline __m512i lane_shl(__m512i x) {
+        if constexpr(s == 0) {
+            return x;
+        } else {
+            return _mm512_slli_epi64(x, s) ^ _mm512_srli_epi64(_mm512_unpacklo_epi64(_mm512_setzero_si512(), x), 64 - s);
+        }
+    }
+
+    // Shift each 128-bit lane right by 0 < s < 128 bits
+    template <int s>
+    inline __m512i lane_shr(__m512i x) {
+        __m512i high_word = _mm512_unpackhi_epi64(x, _mm512_setzero_si512());
+        if constexpr(s < 64) {
+            return _mm512_srli_epi64(x, s) ^ _mm512_slli_epi64(high_word, 64 - s);
+        } else {
+            return _mm512_srli_epi64(high_word, s - 64);
+        }
+    }
+
+    // Same as `fold_reduce`, without the final mask
+    template <int k>
+    inline __m512i fold(__m512i hi) {
+        constexpr auto red = reduction_polynomial<k>();
+        if constexpr(num_reduction_monomials<k>() == 3) {
+            __m512i t = hi ^ lane_shr<k - red>(hi);
+            return t ^ lane_shl<red>(t);
+        } else {
+            constexpr int a = std::get<0>(red), b = std::get<1>(red), c = std::get<2>(red);
+            __m512i t = hi ^ lane_shr<k - a>(hi) ^ lane_shr<k - b>(hi) ^ lane_shr<k - c>(hi);
+            return t ^ lane_shl<a>(t) ^ lane_shl<b>(t) ^ lane_shl<c>(t);
+        }
+    }
+
+    // Same as `initial_mult`, for four elements at once
+    inline void product(__m512i a, __m512i b, __m512i& lo, __m512i& hi) {
+        const __m512i zero = _mm512_setzero_si512();
+        __m512i mid = _mm512_clmulepi64_epi128(a, b, 0x01) ^ _mm512_clmulepi64_epi128(a, b, 0x10);
+        lo = _mm512_clmulepi64_epi128(a, b, 0x00) ^ _mm512_unpacklo_epi64(zero, mid);
+        hi = _mm512_clmulepi64_epi128(a, b, 0x11) ^ _mm512_unpackhi_epi64(mid, zero);
+    }
+
+    // Same as `reduce`, for four elements at once
+    template <int k>
+    inline __m512i reduce(__m512i lo, __m512i hi) {
+        constexpr int s = k - 64;
+        const __m512i mask = _mm512_set_epi64((1ll << s) - 1, -1, (1ll << s) - 1, -1, (1ll << s) - 1, -1, (1ll << s) - 1, -1);
+        // (hi:lo) >> k, folded back in once
+        __m512i top = _mm512_srli_epi64(_mm512_alignr_epi8(hi, lo, 8), s) ^ _mm512_slli_epi64(hi, 64 - s);
+        return (lo ^ fold<k>(top)) & mask;
+    }
+
+    template <int k>
+    inline __m512i mul(__m512i a, __m512i b) {
+        __m512i lo, hi;
+        product(a, b, lo, hi);
+        return reduce<k>(lo, hi);
+    }
+
+    template <int k>
+    void mul_n(GF2k<k>* out, const GF2k<k>* a, const GF2k<k>* b, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m512i x = _mm512_loadu_si512(a + i);
+            __m512i y = _mm512_loadu_si512(b + i);
+            _mm512_storeu_si512(out + i, mul<k>(x, y));
+        }
+        for (; i < n; i++) out[i] = a[i] * b[i];
+    }
+
+    template <int k>
+    void mul_acc_n(GF2k<k>* out, const GF2k<k>* a, const GF2k<k>* b, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m512i x = _mm512_loadu_si512(a + i);
+            __m512i y = _mm512_loadu_si512(b + i);
+            __m512i z = _mm512_loadu_si512(out + i);
+            _mm512_storeu_si512(out + i, z ^ mul<k>(x, y));
+        }
+        for (; i < n; i++) out[i] += a[i] * b[i];
+    }
+
+    // out[i] = a * x[i], or out[i] += a * x[i] when `accumulate`
+    template <int k, bool accumulate>
+    void scale_n(GF2k<k>* out, const GF2k<k>& a, const GF2k<k>* x, std::size_t n) {
+        const __m512i y = _mm512_broadcast_i32x4(a.force_int().reveal());
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m512i prod = mul<k>(_mm512_loadu_si512(x + i), y);
+            if constexpr(accumulate) prod ^= _mm512_loadu_si512(out + i);
+            _mm512_storeu_si512(out + i, prod);
+        }
+        for (; i < n; i++) {
+            if constexpr(accumulate) out[i] += a * x[i]; else out[i] = a * x[i];
+        }
+    }
+
+    template <int k>
+    GF2k<k> dot_n(const GF2k<k>* a, const GF2k<k>* b, std::size_t n) {
+        // Accumulate the unreduced products, and only reduce once at the end
+        __m512i acc_lo = _mm512_setzero_si512(), acc_hi = _mm512_setzero_si512();
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m512i x = _mm512_loadu_si512(a + i);
+            __m512i y = _mm512_loadu_si512(b + i);
+            __m512i lo, hi;
+            product(x, y, lo, hi);
+            acc_lo ^= lo;
+            acc_hi ^= hi;
+        }
+        __m512i acc = reduce<k>(acc_lo, acc_hi);
+        __m256i half = _mm512_castsi512_si256(acc) ^ _mm512_extracti64x4_epi64(acc, 1);
+        GF2k<k> res(int128(_mm256_castsi256_si128(half) ^ _mm256_extracti128_si256(half, 1)));
+        for (; i < n; i++) res += a[i] * b[i];
+        return res;
+    }
+} // namespace detail::avx512
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+
+/**
+ * Element-wise and inner product operations on arrays of field elements.
+ *
+ * For the fields stored in an int128, these use wide carryless multiplications (VPCLMULQDQ)
+ * when the processor supports them, handling 2 (AVX2) or 4 (AVX-512) elements per instruction.
+ */
+namespace batch {
+    /**
+     * out[i] = a[i] * b[i]; `out` is allowed to alias `a` or `b`
+     */
+    template <int k>
+    void mul(GF2k<k>* out, const GF2k<k>* a, const GF2k<k>* b, std::size_t n) {
+        if constexpr(detail::has_wide_kernels<k>()) {
+            static_assert(sizeof(GF2k<k>) == sizeof(__m128i), "Kernels assume densely stored elements");
+            switch (selected_isa()) {
+                case ISA::avx512: return detail::avx512::mul_n<k>(out, a, b, n);
+                case ISA::avx2: return detail::avx2::mul_n<k>(out, a, b, n);
+                case ISA::baseline: break;
+            }
+        }
+        for (std::size_t i = 0; i < n; i++) out[i] = a[i] * b[i];
+    }
+
+    /**
+     * out[i] += a[i] * b[i]
+     */
+    template <int k>
+    void mul_acc(GF2k<k>* out, const GF2k<k>* a, const GF2k<k>* b, std::size_t n) {
+        if constexpr(detail::has_wide_kernels<k>()) {
+            switch (selected_isa()) {
+                case ISA::avx512: return detail::avx512::mul_acc_n<k>(out, a, b, n);
+                case ISA::avx2: return detail::avx2::mul_acc_n<k>(out, a, b, n);
+                case ISA::baseline: break;
+            }
+        }
+        for (std::size_t i = 0; i < n; i++) out[i] += a[i] * b[i];
+    }
+
+    /**
+     * out[i] = a * x[i]; `out` is allowed to alias `x`
+     */
+    template <int k>
+    void scale(GF2k<k>* out, const GF2k<k>& a, const GF2k<k>* x, std::size_t n) {
+        if constexpr(detail::has_wide_kernels<k>()) {
+            switch (selected_isa()) {
+                case ISA::avx512: return detail::avx512::scale_n<k, false>(out, a, x, n);
+                case ISA::avx2: return detail::avx2::scale_n<k, false>(out, a, x, n);
+                case ISA::baseline: break;
+            }
+        }
+        for (std::size_t i = 0; i < n; i++) out[i] = a * x[i];
+    }
+
+    /**
+     * out[i] += a * x[i]
+     */
+    template <int k>
+    void axpy(GF2k<k>* out, const GF2k<k>& a, const GF2k<k>* x, std::size_t n) {
+        if constexpr(detail::has_wide_kernels<k>()) {
+            switch (selected_isa()) {
+                case ISA::avx512: return detail::avx512::scale_n<k, true>(out, a, x, n);
+                case ISA::avx2: return detail::avx2::scale_n<k, true>(out, a, x, n);
+                case ISA::baseline: break;
+            }
+        }
+        for (std::size_t i = 0; i < n; i++) out[i] += a * x[i];
+    }
+
+    /**
+     * \sum_i a[i] * b[i]
+     */
+    template <int k>
+    GF2k<k> dot(const GF2k<k>* a, const GF2k<k>* b, std::size_t n) {
+        if constexpr(detail::has_wide_kernels<k>()) {
+            switch (selected_isa()) {
+                case ISA::avx512: return detail::avx512::dot_n<k>(a, b, n);
+                case ISA::avx2: return detail::avx2::dot_n<k>(a, b, n);
+                case ISA::baseline: break;
+            }
+        }
+        GF2kAccumulator<k> res;
+        for (std::size_t i = 0; i < n; i++) res.add_product(a[i], b[i]);
+        return res.reduce();
+    }
+
+    /**
+     * xs[i] = xs[i]^-1, in place; zeroes are left untouched
+     *
+     * Uses Montgomery's trick: a single inversion and 3(n - 1) multiplications
+     */
+    template <int k>
+    void inv(GF2k<k>* xs, std::size_t n) {
+        if constexpr(detail::is_table_based<k>()) { // Inversion is a lookup already
+            for (std::size_t i = 0; i < n; i++) xs[i] = xs[i].inv();
+            return;
+        }
+        // prefix[i] = \prod_{j < i} xs[j]
+        std::vector<GF2k<k>> prefix(n);
+        GF2k<k> acc(1);
+        for (std::size_t i = 0; i < n; i++) {
+            prefix[i] = acc;
+            if (xs[i] != GF2k<k>(0)) acc *= xs[i];
+        }
+        // acc = (\prod_{j <= i} xs[j])^-1 while walking back down
+        acc = acc.inv();
+        for (std::size_t i = n; i-- > 0;) {
+            if (xs[i] == GF2k<k>(0)) continue;
+            GF2k<k> res = acc * prefix[i];
+            acc *= xs[i];
+            xs[i] = res;
+        }
+    }
+
+    template <int k>
+    void inv(std::vector<GF2k<k>>& xs) {
+        inv(xs.data(), xs.size());
+    }
+
+    /**
+     * \sum_i liftGF<k2>(a[i]) * b[i], for a[i] in a small subfield
+     *
+     * Mixed subfield/extension field products: the b[i] are first summed per value of a[i], and then
+     * per bit of a[i], so that only k full multiplications with the lifted basis remain
+     */
+    template <int k2, int k>
+    GF2k<k2> lifted_dot(const GF2k<k>* a, const GF2k<k2>* b, std::size_t n) {
+        static_assert(k <= 8, "Bucketing by value needs a small subfield");
+        std::array<GF2k<k2>, (1 << k)> buckets;
+        buckets.fill(GF2k<k2>(0));
+        for (std::size_t i = 0; i < n; i++) buckets[a[i].force_int()] += b[i];
+
+        GF2kAccumulator<k2> res;
+        for (int bit = 0; bit < k; bit++) {
+            GF2k<k2> sum(0);
+            for (int v = 0; v < (1 << k); v++) {
+                if ((v >> bit) & 1) sum += buckets[v];
+            }
+            res.add_product(gflifttables::lift_v<k, k2>[bit], sum);
+        }
+        return res.reduce();
+    }
+
+    template <int k>
+    void mul(std::vector<GF2k<k>>& out, const std::vector<GF2k<k>>& a, const std::vector<GF2k<k>>& b) {
+        assert(a.size() == b.size());
+        out.resize(a.size());
+        mul(out.data(), a.data(), b.data(), a.size());
+    }
+
+    template <int k>
+    void mul_acc(std::vector<GF2k<k>>& out, const std::vector<GF2k<k>>& a, const std::vector<GF2k<k>>& b) {
+        assert(a.size() == b.size() && out.size() == a.size());
+        mul_acc(out.data(), a.data(), b.data(), a.size());
+    }
+
+    template <int k>
+    GF2k<k> dot(const std::vector<GF2k<k>>& a, const std::vector<GF2k<k>>& b) {
+        assert(a.size() == b.size());
+        return dot(a.data(), b.data(), a.size());
+    }
+} // namespace batch
@@ -0,0 +1,65 @@
+/*
+Copyright (c) 2022, COSIC-KU Leuven, Kasteelpark Arenberg 10, bus 2452, B-3001 Leuven-Heverlee, Belgium.
+
+All rights reserved
+*/
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A growable sequence of bits, packed 64 to a word, lowest index in the lowest bit
+ *
+ * Bits past size() in the last word are always zero, so reads a little past the end see zero padding.
+ */
+class BitVector {
+    public:
+        BitVector() = default;
+        explicit BitVector(std::size_t n) : m_words((n + 63) / 64, 0), m_size(n) {}
+
+        std::size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        const std::vector<uint64_t>& words() const { return m_words; }
+
+        void reserve(std::size_t n) { m_words.reserve((n + 63) / 64); }
+
+        void push_back(bool bit) {
+            if (m_size % 64 == 0) m_words.push_back(0);
+            m_words.back() |= uint64_t(bit) << (m_size % 64);
+            m_size++;
+        }
+
+        bool operator[](std::size_t i) const {
+            assert(i < m_size);
+            return (m_words[i / 64] >> (i % 64)) & 1;
+        }
+
+        /**
+         * Grow with zeroes or shrink to `n` bits
+         */
+        void resize(std::size_t n) {
+            m_words.resize((n + 63) / 64, 0);
+            m_size = n;
+            if (n % 64 != 0) m_words.back() &= (uint64_t(1) << (n % 64)) - 1;
+        }
+
+        /**
+         * The `len` <= 64 bits starting at index `i`, with bit i lowest; bits past the end read as zero
+         */
+        uint64_t bits(std::size_t i, unsigned len) const {
+            assert(len <= 64);
+            std::size_t w = i / 64;
+            unsigned offset = i % 64;
+            if (len == 0 || w >= m_words.size()) return 0;
+            uint64_t res = m_words[w] >> offset;
+            if (offset + len > 64 && w + 1 < m_words.size()) res |= m_words[w + 1] << (64 - offset);
+            return len == 64 ? res : res & ((uint64_t(1) << len) - 1);
+        }
+
+    private:
+        std::vector<uint64_t> m_words;
+        std::size_t m_size = 0;
+};
@@ -13,7 +13,9 @@ All rights reserved
 /* Make sure we only call these things once */
 static bool cpu_initialized= false;
 
-static bool adx_flag, bmi2_flag, avx2_flag, avx_flag, pclmul_flag, aes_flag;
+static bool adx_flag, bmi2_flag, avx2_flag, avx_flag, pclmul_flag, aes_flag,
+    avx512f_flag, avx512bw_flag, vpclmul_flag, vaes_flag, ymm_state_flag,
+    zmm_state_flag;
 
 inline bool check_cpu(int func, bool ecx, int feature)
 {
@@ -23,6 +25,14 @@ inline bool check_cpu(int func, bool ecx, int feature)
   return ((ecx ? cx : bx) >> feature) & 1;
 }
 
+/* The OS-enabled state components (XCR0); only valid when OSXSAVE is set */
+inline unsigned long long read_xcr0()
+{
+  unsigned int ax, dx;
+  __asm__ __volatile__("xgetbv" : "=a"(ax), "=d"(dx) : "c"(0));
+  return ((unsigned long long) dx << 32) | ax;
+}
+
 inline void initialize_flags()
 {
   cpu_initialized= true;
@@ -32,6 +42,15 @@ inline void initialize_flags()
   avx_flag= check_cpu(1, true, 28);
   pclmul_flag= check_cpu(1, true, 1);
   aes_flag= check_cpu(1, true, 25);
+  avx512f_flag= check_cpu(7, false, 16);
+  avx512bw_flag= check_cpu(7, false, 30);
+  vpclmul_flag= check_cpu(7, true, 10);
+  vaes_flag= check_cpu(7, true, 9);
+  /* The wide registers are only usable when the OS saves them on context switches:
+     SSE and AVX state (XCR0 bits 1-2), plus the opmask and ZMM state (bits 5-7) */
+  unsigned long long xcr0= check_cpu(1, true, 27) ? read_xcr0() : 0;
+  ymm_state_flag= (xcr0 & 0x6) == 0x6;
+  zmm_state_flag= (xcr0 & 0xe6) == 0xe6;
 }
 
 inline bool cpu_has_adx()
@@ -88,4 +107,62 @@ inline bool cpu_has_aes()
   return aes_flag;
 }
 
+inline bool cpu_has_avx512f()
+{
+  if (!cpu_initialized)
+    {
+      initialize_flags();
+    }
+  return avx512f_flag;
+}
+
+inline bool cpu_has_avx512bw()
+{
+  if (!cpu_initialized)
+    {
+      initialize_flags();
+    }
+  return avx512bw_flag;
+}
+
+/* Carryless multiplication on 256 and 512 bit vectors */
+inline bool cpu_has_vpclmul()
+{
+  if (!cpu_initialized)
+    {
+      initialize_flags();
+    }
+  return vpclmul_flag;
+}
+
+/* AES rounds on 256 and 512 bit vectors */
+inline bool cpu_has_vaes()
+{
+  if (!cpu_initialized)
+    {
+      initialize_flags();
+    }
+  return vaes_flag;
+}
+
+/* Whether the OS saves the YMM registers, needed for any AVX code */
+inline bool os_has_ymm_state()
+{
+  if (!cpu_initialized)
+    {
+      initialize_flags();
+    }
+  return ymm_state_flag;
+}
+
+/* Whether the OS saves the opmask and ZMM registers, needed for any AVX-512 code */
+inline bool os_has_zmm_state()
+{
+  if (!cpu_initialized)
+    {
+      initialize_flags();
+    }
+  return zmm_state_flag;
+}
+
 #endif /* TOOLS_CPU_SUPPORT_H_ */
@@ -9,6 +9,7 @@ All rights reserved
 
 #include "log/config.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <iostream>
@@ -17,12 +18,569 @@ All rights reserved
 
 #include "decoder.h"
 #include "arith.h"
+#include "bitvector.h"
+#include "gfvector.h"
 
 
 
+template <int k>
+GF2k<k> random_el() {
+    if constexpr(k > 64) {
+        return GF2k<k>(detail::int128((long long)std::rand() << 32 ^ std::rand(), (long long)std::rand() << 32 ^ std::rand()));
+    } else {
+        return GF2k<k>((long long)std::rand() << 32 ^ std::rand());
+    }
+}
+
+template <int k>
+void test_batch() {
+    // Odd length, to also hit the scalar tail of the vectorized kernels
+    std::vector<GF2k<k>> a(1001), b(1001), prod(1001), acc(1001);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        a[i] = random_el<k>();
+        b[i] = random_el<k>();
+        acc[i] = random_el<k>();
+    }
+    auto expected_acc = acc;
+    GF2k<k> expected_dot(0);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        expected_dot += a[i] * b[i];
+        expected_acc[i] += a[i] * b[i];
+    }
+
+    batch::mul(prod, a, b);
+    for (std::size_t i = 0; i < a.size(); i++) assert(prod[i] == a[i] * b[i]);
+    batch::mul_acc(acc, a, b);
+    assert(acc == expected_acc);
+    assert(batch::dot(a, b) == expected_dot);
+}
+
+template <int k>
+void test_accumulator() {
+    std::vector<GF2k<k>> a(100), b(100);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        a[i] = random_el<k>();
+        b[i] = random_el<k>();
+    }
+    GF2k<k> expected(0);
+    GF2kAccumulator<k> first, second;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        expected += a[i] * b[i] + a[i];
+        auto& acc = i % 2 ? first : second;
+        acc.add_product(a[i], b[i]);
+        acc.add(a[i]);
+    }
+    first += second;
+    assert(first.reduce() == expected);
+}
+
+// Compare the table-based arithmetic against carryless multiplication
+template <int k>
+void test_tables() {
+    using F = typename GF2k<k>::F;
+    for (int i = 0; i < 1000; i++) {
+        GF2k<k> a = random_el<k>(), b = random_el<k>();
+        F expected = detail::extract<F>(detail::reduce<k, F>(detail::initial_mult<k>(a.force_int(), b.force_int())));
+        assert((a * b).force_int() == expected);
+        if (a != GF2k<k>(0)) assert(a * a.inv() == GF2k<k>(1));
+    }
+}
+
+template <int k>
+void test_inverse() {
+    for (int i = 0; i < 100; i++) {
+        GF2k<k> a = random_el<k>();
+        if (a == GF2k<k>(0)) continue;
+        assert(a * a.inv() == GF2k<k>(1));
+        assert(a.square() == a * a);
+        assert(a.frobenius(3) == a * a * a * a * a * a * a * a);
+        assert(a.frobenius(k) == a);
+        assert(a.pow(13) == a.square().square().square() * a.square().square() * a);
+        assert(a.pow(0) == GF2k<k>(1));
+    }
+}
+
+template <int k>
+void test_interpolation() {
+    std::vector<GF2k<k>> xs(50);
+    for (std::size_t i = 0; i < xs.size(); i++) xs[i] = random_el<k>();
+    xs[7] = GF2k<k>(0);
+    auto inverted = xs;
+    batch::inv(inverted);
+    for (std::size_t i = 0; i < xs.size(); i++) assert(inverted[i] == xs[i].inv());
+
+    std::array<GF2k<k>, 6> poly;
+    for (auto& c : poly) c = random_el<k>();
+    std::vector<GF2k<k>> xcoords, ys, consecutive_ys;
+    for (int i = 0; i < 6; i++) {
+        xcoords.push_back(GF2k<k>(3 * i + 5));
+        ys.push_back(poly_eval(poly, xcoords.back()));
+        consecutive_ys.push_back(poly_eval(poly, GF2k<k>(i)));
+    }
+    GF2k<k> x = random_el<k>();
+    assert(interpolate_with_preprocessing(interpolate_preprocess(xcoords, x), ys) == poly_eval(poly, x));
+    assert(interpolate(consecutive_ys, x) == poly_eval(poly, x));
+    // Evaluating in one of the interpolation points
+    assert(interpolate_with_preprocessing(interpolate_preprocess(xcoords, xcoords[2]), ys) == ys[2]);
+
+    // One set of weights for many evaluation points, including the points themselves
+    Barycentric<k> bary(xcoords);
+    for (int i = 0; i < 5; i++) {
+        GF2k<k> z = random_el<k>();
+        assert(bary.evaluate(ys, z) == poly_eval(poly, z));
+        assert(bary.evaluate(ys, xcoords[i]) == ys[i]);
+    }
+    assert(Barycentric<k>(6).evaluate(consecutive_ys, x) == poly_eval(poly, x));
+
+    // Coefficients from the values in (0, ..., 5), and the special case of two points
+    std::array<GF2k<k>, 6> vals;
+    std::copy(consecutive_ys.begin(), consecutive_ys.end(), vals.begin());
+    assert(interpolate_poly(vals) == poly);
+    std::array<GF2k<k>, 2> line{poly[0], poly[0] + poly[1]};
+    assert((interpolate_poly(line) == std::array<GF2k<k>, 2>{poly[0], poly[1]}));
+}
+
+template <int k, int k2>
+void test_lift() {
+    std::vector<GF2k<k>> a(100);
+    std::vector<GF2k<k2>> b(100);
+    GF2k<k2> expected(0);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        a[i] = random_el<k>();
+        b[i] = random_el<k2>();
+        // Lifting is linear in the bits of the subfield element
+        GF2k<k2> lifted(0);
+        for (int j = 0; j < k; j++) {
+            if ((a[i].force_int() >> j) & 1) lifted += gflifttables::lift_v<k, k2>[j];
+        }
+        assert(liftGF<k2>(a[i]) == lifted);
+        expected += lifted * b[i];
+    }
+    assert(batch::lifted_dot(a.data(), b.data(), a.size()) == expected);
+}
+
+// Specialized reduction against the straightforward one, on random products
+template <int k>
+void test_reduce() {
+    using F = typename GF2k<k>::F;
+    for (int i = 0; i < 1000; i++) {
+        auto prod = detail::initial_mult<k>(random_el<k>().force_int(), random_el<k>().force_int());
+        assert((detail::reduce<k, F>(prod) == detail::reduce_generic<k, F>(prod)));
+    }
+}
+
+template <int k>
+void test_gfvector() {
+    GFVector<k> x, y;
+    for (int i = 0; i < 101; i++) {
+        x.push_back(random_el<k>());
+        y.push_back(random_el<k>());
+    }
+    assert(reinterpret_cast<std::uintptr_t>(x.data()) % 64 == 0);
+    GF2k<k> a = random_el<k>();
+    GFVector<k> expected = y;
+    for (std::size_t i = 0; i < y.size(); i++) expected[i] += a * x[i];
+    y.axpy(a, x);
+    assert(std::equal(y.begin(), y.end(), expected.begin()));
+
+    auto tail = y.subspan(1, 100);
+    for (std::size_t i = 1; i < y.size(); i++) expected[i] *= a;
+    tail.scale(a);
+    assert(std::equal(y.begin(), y.end(), expected.begin()));
+    assert(x.subspan(3, 10).dot(y.subspan(5, 10)) == batch::dot(x.data() + 3, y.data() + 5, 10));
+}
+
+// Syndrome fast path against Berlekamp-Welch, with and without errors
+template <int D, int E, int k, std::size_t N>
+void test_decode() {
+    // Distinct, but not the default (1, ..., N)
+    GF2k<k> stretch = random_el<k>();
+    if (stretch == GF2k<k>(0)) stretch = GF2k<k>(1);
+    std::array<GF2k<k>, N> xcoords;
+    for (std::size_t i = 0; i < N; i++) xcoords[i] = stretch * GF2k<k>(i + 1);
+    Decoder<D, E, k, N> decoder(xcoords);
+    for (int i = 0; i < 100; i++) {
+        std::array<GF2k<k>, D + 1> poly;
+        for (auto& c : poly) c = random_el<k>();
+        auto shares = encode<D, k, N>(xcoords, poly);
+        assert(decoder.encode(poly) == shares);
+        assert(decoder.consistent(shares));
+        auto [honest, no_cheaters] = decoder.decode(shares);
+        assert(honest == poly && no_cheaters.empty());
+
+        std::vector<int> cheaters;
+        for (int j = 0; j < 1 + i % E; j++) {
+            int c = (j * 7 + i) % N;
+            if (std::find(cheaters.begin(), cheaters.end(), c + 1) != cheaters.end()) continue;
+            shares[c] += GF2k<k>(1 + j);
+            cheaters.push_back(c + 1);
+        }
+        std::sort(cheaters.begin(), cheaters.end());
+        assert(!decoder.consistent(shares));
+        auto [recovered, found] = decoder.decode(shares);
+        assert(recovered == poly && found == cheaters);
+        assert((recovered == detail::berlekamp_welch<D, E>(xcoords, shares)));
+    }
+}
+
+// Gao's algorithm against Berlekamp-Welch, up to E errors
+template <int D, int E, int k, std::size_t N>
+void test_gao() {
+    std::array<GF2k<k>, N> xcoords;
+    for (std::size_t i = 0; i < N; i++) xcoords[i] = GF2k<k>(i + 1);
+    for (int i = 0; i < 20; i++) {
+        std::array<GF2k<k>, D + 1> poly;
+        for (auto& c : poly) c = random_el<k>();
+        auto shares = encode<D, k, N>(xcoords, poly);
+        for (int j = 0; j < i % (E + 1); j++) shares[std::rand() % N] = random_el<k>();
+
+        assert((detail::gao<D, E>(xcoords, shares) == poly));
+        assert((detail::gao<D, E>(xcoords, shares) == detail::berlekamp_welch<D, E>(xcoords, shares)));
+        auto [bw, bw_cheaters] = decode<D, E>(xcoords, shares);
+        auto [gao, gao_cheaters] = decode<D, E, Gao>(xcoords, shares);
+        assert(bw == gao && bw_cheaters == gao_cheaters);
+    }
+    // Too many errors for the degree; in small fields, random shares are often close enough to a codeword
+    if constexpr (k < 12) return;
+    std::array<GF2k<k>, N> garbage;
+    for (auto& el : garbage) el = random_el<k>();
+    bool thrown = false;
+    try {
+        detail::gao<D, E>(xcoords, garbage);
+    } catch (const invalid_sharing&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+// Known-bad shares as erasures, leaving room to correct more errors among the others
+template <int D, int E, int k, std::size_t N>
+void test_erasures() {
+    static_assert(N >= D + 1 + 3 * E, "The erasures would not be used");
+    const auto& decoder = default_decoder<D, E, k, N>();
+    constexpr int ERASED = E;
+    constexpr int ERRORS = (N - ERASED - D - 1) / 2;
+    for (int i = 0; i < 20; i++) {
+        std::array<GF2k<k>, D + 1> poly;
+        for (auto& c : poly) c = random_el<k>();
+        auto shares = encode<D, k, N>(poly);
+
+        // Garbage in the erased positions 1..ERASED, errors right after them
+        std::vector<int> erased;
+        for (int j = 0; j < ERASED; j++) {
+            shares[j] = random_el<k>();
+            erased.push_back(j + 1);
+        }
+        auto [honest, no_cheaters] = decoder.decode(shares, erased);
+        assert(honest == poly && no_cheaters.empty());
+
+        std::vector<int> cheaters;
+        for (int j = 0; j < ERRORS; j++) {
+            shares[ERASED + 2 * j] += GF2k<k>(1);
+            cheaters.push_back(ERASED + 2 * j + 1);
+        }
+        auto [recovered, found] = decoder.decode(shares, erased);
+        assert(recovered == poly && found == cheaters);
+    }
+}
+
+// One erasure plus E errors, where the erasure would leave too little redundancy and all shares get decoded instead
+template <int D, int E, int k, int N>
+void test_erasure_fallback() {
+    static_assert(N - 1 < D + 1 + 2 * E && N > E + 1, "Needs an unusable erasure of party 2 and room for E errors after it");
+    const auto& decoder = default_decoder<D, E, k, N>();
+    const std::vector<int> erased{2};
+    assert(!decoder.erasable(erased));
+    for (int i = 0; i < 20; i++) {
+        std::array<GF2k<k>, D + 1> poly;
+        for (auto& c : poly) c = random_el<k>();
+        auto shares = encode<D, k, N>(poly);
+
+        std::vector<int> cheaters;
+        for (int j = 0; j < E; j++) {
+            shares[2 + j] += GF2k<k>(1);
+            cheaters.push_back(3 + j);
+        }
+        auto [recovered, found] = decoder.decode(shares, erased);
+        assert(recovered == poly && found == cheaters);
+
+        // Batched, with an honest sharing next to it
+        GFVector<k> batch(2 * N);
+        auto honest = encode<D, k, N>(poly);
+        for (int j = 0; j < N; j++) {
+            batch[2 * j] = honest[j];
+            batch[2 * j + 1] = shares[j];
+        }
+        auto res = decoder.decode_batch(batch, erased);
+        assert(res.secrets[0] == poly[0] && res.secrets[1] == poly[0]);
+        assert(res.cheaters.size() == 1 && res.cheaters[0].first == 1 && res.cheaters[0].second == cheaters);
+
+        // Only the erased party wrong: corrected, but not reported
+        shares = honest;
+        shares[1] = random_el<k>();
+        auto [erased_recovered, erased_found] = decoder.decode(shares, erased);
+        assert(erased_recovered == poly && erased_found.empty());
+    }
+}
+
+// Batched decoding against decoding every sharing on its own
+template <int D, int E, int k, int N>
+void test_decode_batch() {
+    const std::size_t count = 301;
+    GFVector<k> shares(N * count);
+    std::vector<std::array<GF2k<k>, N>> sharings(count);
+    for (std::size_t s = 0; s < count; s++) {
+        std::array<GF2k<k>, D + 1> poly;
+        for (auto& c : poly) c = random_el<k>();
+        sharings[s] = encode<D, k, N>(poly);
+        if (s % 7 == 3) sharings[s][s % N] += GF2k<k>(1);
+        for (int j = 0; j < N; j++) shares[j * count + s] = sharings[s][j];
+    }
+
+    auto res = decode_batch<D, E, N, k>(shares);
+    assert(res.secrets.size() == count);
+    assert(res.cheaters.size() == (count + 3) / 7);
+    for (std::size_t s = 0; s < count; s++) {
+        auto [poly, cheaters] = decode<D, E>(sharings[s]);
+        assert(res.secrets[s] == poly[0]);
+        if (!cheaters.empty()) {
+            auto it = std::find_if(res.cheaters.begin(), res.cheaters.end(), [&](const auto& c) { return c.first == s; });
+            assert(it != res.cheaters.end() && it->second == cheaters);
+        }
+    }
+
+    // With the last party erased: garbage in its column, and errors elsewhere if there is redundancy left for them
+    const std::vector<int> erased{N};
+    constexpr bool correctable = N - 1 >= D + 1 + 2 * E;
+    for (std::size_t s = 0; s < count; s++) {
+        std::array<GF2k<k>, D + 1> poly;
+        for (auto& c : poly) c = random_el<k>();
+        sharings[s] = encode<D, k, N>(poly);
+        sharings[s][N - 1] = random_el<k>();
+        if (correctable && s % 5 == 1) sharings[s][s % (N - 1)] += GF2k<k>(1);
+        for (int j = 0; j < N; j++) shares[j * count + s] = sharings[s][j];
+    }
+    for (int round = 0; round < 2; round++) { // The second one finds the erasure tables cached
+        auto erasure_res = decode_batch<D, E, N, k>(shares, erased);
+        assert(erasure_res.cheaters.size() == (correctable ? (count + 3) / 5 : 0));
+        for (std::size_t s = 0; s < count; s++) {
+            auto [poly, cheaters] = decode<D, E>(sharings[s], erased);
+            assert(erasure_res.secrets[s] == poly[0]);
+            assert(std::find(cheaters.begin(), cheaters.end(), N) == cheaters.end());
+        }
+    }
+}
+
+// Additive FFT against direct evaluation, on the plain and lifted points
+template <int k, int k2>
+void test_additive_fft() {
+    constexpr int m = std::min(6, k2);
+    constexpr std::size_t n = std::size_t(1) << m;
+    const auto& fft = additive_fft<k>();
+    std::array<GF2k<k>, n> poly;
+    for (auto& c : poly) c = random_el<k>();
+
+    for (std::uint64_t shift : {std::uint64_t(0), std::uint64_t(3) << m}) {
+        std::vector<GF2k<k>> a(poly.begin(), poly.end());
+        fft.to_novel(a.data(), m);
+        fft.fft(a.data(), m, shift);
+        for (std::size_t i = 0; i < n; i++) assert(a[i] == poly_eval(poly, GF2k<k>(shift ^ i)));
+        fft.ifft(a.data(), m, shift);
+        fft.from_novel(a.data(), m);
+        assert(std::equal(a.begin(), a.end(), poly.begin()));
+    }
+
+    std::array<GF2k<k>, 21> message;
+    for (auto& c : message) c = random_el<k>();
+    assert((fft.template encode<20, 100>(message) == encode<20, k, 100>(evaluation_points<k, 100>(), message)));
+
+    const auto& lifted = lifted_additive_fft<k2, k>();
+    std::vector<GF2k<k>> a(poly.begin(), poly.end());
+    lifted.to_novel(a.data(), m);
+    lifted.fft(a.data(), m);
+    for (std::size_t i = 0; i < n; i++) assert(a[i] == poly_eval(poly, liftGF<k>(GF2k<k2>(i))));
+}
+
+// Karatsuba and Toom-3 against schoolbook multiplication, on balanced and unbalanced operands
+template <int k>
+void test_poly_mul() {
+    for (auto [na, nb] : {std::pair<std::size_t, std::size_t>{40, 40}, {77, 101}, {33, 500}, {800, 790}, {1000, 700}, {1100, 1030}}) {
+        std::vector<GF2k<k>> a(na), b(nb);
+        for (auto& c : a) c = random_el<k>();
+        for (auto& c : b) c = random_el<k>();
+        std::vector<GF2k<k>> expected(na + nb - 1, GF2k<k>(0)), karatsuba(expected), toom(expected);
+        detail::schoolbook_mul(a.data(), na, b.data(), nb, expected.data());
+        detail::karatsuba_mul(a.data(), na, b.data(), nb, karatsuba.data());
+        detail::toom3_mul(a.data(), na, b.data(), nb, toom.data());
+        assert(karatsuba == expected && toom == expected && poly_mul(a, b) == expected);
+    }
+
+    std::array<GF2k<k>, 50> x;
+    std::array<GF2k<k>, 3> y;
+    for (auto& c : x) c = random_el<k>();
+    for (auto& c : y) c = random_el<k>();
+    auto small = poly_mul(x, y);
+    auto large = poly_mul(x, x);
+    auto dynamic = poly_mul(std::vector<GF2k<k>>(x.begin(), x.end()), std::vector<GF2k<k>>(y.begin(), y.end()));
+    assert(std::equal(small.begin(), small.end(), dynamic.begin(), dynamic.end()));
+    dynamic = poly_mul(std::vector<GF2k<k>>(x.begin(), x.end()), std::vector<GF2k<k>>(x.begin(), x.end()));
+    assert(std::equal(large.begin(), large.end(), dynamic.begin(), dynamic.end()));
+}
+
+// Subproduct tree against Horner and the quadratic interpolation, also through the thresholds in encode and Barycentric
+template <int k>
+void test_subproduct_tree() {
+    std::vector<GF2k<k>> xs, poly;
+    for (int i = 0; i < 300; i++) {
+        xs.emplace_back(5 * i + 3);
+        poly.push_back(random_el<k>());
+    }
+    SubproductTree<k> tree(xs);
+    auto values = tree.evaluate(poly);
+    std::array<GF2k<k>, 300> coeffs;
+    std::copy(poly.begin(), poly.end(), coeffs.begin());
+    for (std::size_t i = 0; i < xs.size(); i++) assert(values[i] == poly_eval(coeffs, xs[i]));
+    assert(tree.interpolate(values) == poly);
+    GF2k<k> x = random_el<k>();
+    assert(Barycentric<k>(xs).coefficients(x) == interpolate_preprocess(xs, x));
+
+    constexpr std::size_t D = detail::SUBPRODUCT_EVALUATION_THRESHOLD, N = D + 50;
+    std::array<GF2k<k>, D + 1> message;
+    std::array<GF2k<k>, N> xcoords;
+    for (auto& c : message) c = random_el<k>();
+    for (std::size_t i = 0; i < N; i++) xcoords[i] = GF2k<k>(3 * i + 1);
+    auto shares = encode<D, k, N>(xcoords, message);
+    for (std::size_t i = 0; i < N; i += 37) assert(shares[i] == poly_eval(message, xcoords[i]));
+
+    std::vector<GF2k<k>> many(xcoords.begin(), xcoords.end());
+    many.resize(detail::SUBPRODUCT_WEIGHTS_THRESHOLD);
+    for (std::size_t i = N; i < many.size(); i++) many[i] = GF2k<k>(3 * i + 1);
+    std::vector<GF2k<k>> ys(many.size());
+    for (std::size_t i = 0; i < many.size(); i++) ys[i] = poly_eval(message, many[i]);
+    Barycentric<k> bary(many);
+    assert(bary.evaluate(ys, x) == poly_eval(message, x));
+    assert(bary.evaluate(ys, many[7]) == ys[7]);
+}
+
+// Packed bits against std::vector<bool>, with windows across word boundaries and past the end
+void test_bit_vector() {
+    std::vector<bool> expected;
+    BitVector bits;
+    for (int i = 0; i < 300; i++) {
+        bool bit = std::rand() & 1;
+        expected.push_back(bit);
+        bits.push_back(bit);
+    }
+    assert(bits.size() == expected.size());
+    for (std::size_t i = 0; i < expected.size(); i++) assert(bits[i] == expected[i]);
+    for (std::size_t i = 0; i < expected.size(); i += 7) {
+        for (unsigned len : {1u, 3u, 17u, 64u}) {
+            uint64_t window = bits.bits(i, len);
+            for (unsigned j = 0; j < len; j++) assert(((window >> j) & 1) == (i + j < expected.size() && expected[i + j]));
+        }
+    }
+
+    bits.resize(130);
+    bits.resize(200);
+    for (std::size_t i = 0; i < 200; i++) assert(bits[i] == (i < 130 && expected[i]));
+}
+
 /****** Main driver for some testing ******/
 int main() {
     std::srand(42);
+    test_reduce<K_EXT>();
+    test_reduce<128>();
+    test_reduce<120>();
+    test_reduce<65>();
+    test_reduce<64>();
+    test_reduce<63>();
+    test_reduce<33>();
+    test_reduce<27>();
+    test_reduce<17>();
+
+    test_batch<K_EXT>();
+    test_batch<120>();
+    test_batch<65>();
+    test_batch<128>();
+    test_batch<63>();
+    test_accumulator<K_EXT>();
+    test_accumulator<128>();
+    test_accumulator<63>();
+    test_accumulator<27>();
+    test_accumulator<K>();
+    test_accumulator<12>();
+    test_tables<9>();
+    test_tables<10>();
+    test_tables<11>();
+    test_tables<12>();
+    test_tables<13>();
+    test_tables<14>();
+    test_tables<15>();
+    test_tables<16>();
+    test_inverse<K_EXT>();
+    test_inverse<128>();
+    test_inverse<64>();
+    test_inverse<63>();
+    test_inverse<27>();
+    test_inverse<17>();
+    test_inverse<12>();
+    test_inverse<K>();
+    test_interpolation<K_EXT>();
+    test_interpolation<27>();
+    test_interpolation<12>();
+    test_interpolation<K>();
+    test_lift<K, K_EXT>();
+    test_gfvector<K_EXT>();
+    test_gfvector<63>();
+    test_gfvector<K>();
+    test_lift<4, 64>();
+    test_lift<7, 28>();
+    test_lift<5, 10>();
+    test_additive_fft<K_EXT, K>();
+    test_additive_fft<28, 7>();
+    test_additive_fft<10, 5>();
+    {
+        // Large enough for encode to go through the additive FFT
+        static_assert(detail::prefer_fft_encode<60, 12, 200>());
+        std::array<GF2k<12>, 61> poly;
+        for (auto& c : poly) c = random_el<12>();
+        assert((encode<60, 12, 200>(poly) == encode<60, 12, 200>(evaluation_points<12, 200>(), poly)));
+        assert((default_decoder<60, 0, 12, 200>().encode(poly) == encode<60, 12, 200>(poly)));
+    }
+    test_poly_mul<K_EXT>();
+    test_poly_mul<40>();
+    test_poly_mul<16>();
+    test_poly_mul<8>();
+    test_subproduct_tree<K_EXT>();
+    test_subproduct_tree<27>();
+    test_subproduct_tree<16>();
+    test_bit_vector();
+    test_decode<T, T, K_EXT, N>();
+    {
+        // Precomputed tables for the default points against evaluating in them directly
+        std::array<GF2k<27>, 3> poly{random_el<27>(), random_el<27>(), random_el<27>()};
+        assert((encode<2, 27, 7>(poly) == encode<2, 27, 7>(evaluation_points<27, 7>(), poly)));
+        auto lifted = lifted_decoder<T, T, K, K_EXT, N>().encode({GF2k<K_EXT>(1), GF2k<K_EXT>(1)});
+        for (int i = 0; i < N; i++) assert(lifted[i] == liftGF<K_EXT>(GF2k<K>(i + 1)) + GF2k<K_EXT>(1));
+    }
+    test_decode<1, 1, K, 4>();
+    test_decode<2, 1, 27, 5>();
+    test_decode<3, 2, 12, 9>();
+    test_gao<T, T, K_EXT, N>();
+    test_gao<1, 1, K, 4>();
+    test_gao<2, 1, 27, 5>();
+    test_gao<10, 10, 64, 31>();
+    test_gao<33, 33, 16, 100>();
+    test_gao<20, 5, 12, 40>();
+    test_erasures<1, 1, K_EXT, 6>();
+    test_erasures<4, 2, 16, 13>();
+    test_erasures<3, 2, 27, 12>();
+    test_erasure_fallback<T, T, K_EXT, N>();
+    test_erasure_fallback<4, 4, 16, 13>();
+    test_decode_batch<T, T, K, N>();
+    test_decode_batch<1, 1, 27, 4>();
+    test_decode_batch<2, 1, 40, 6>();
+
     std::array<GF2k<K_EXT>, N> xcoords;
     for (int i = 0; i < N; i++) xcoords[i] = liftGF<K_EXT>(GF2k<K>(i + 1));
     for (int i = 0; i < 1000; i++) {
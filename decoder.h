@@ -5,14 +5,21 @@ All rights reserved
 */
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <exception>
+#include <map>
+#include <mutex>
 #include <stdexcept>
 #include <utility>
 #include <vector>
 
+#include "additive_fft.h"
 #include "arith.h"
+#include "gfvector.h"
+#include "polynomial.h"
+#include "subproduct_tree.h"
 
 class invalid_sharing : public std::runtime_error {
     public:
@@ -70,25 +77,98 @@ namespace detail {
  */
 template <unsigned long L, int k>
 GF2k<k> poly_eval(const std::array<GF2k<k>, L>& poly, GF2k<k> x) {
-    GF2k<k> pt(1);
+    // Horner's rule
     GF2k<k> res(0);
-    for (GF2k<k> c : poly) {
-        res += c * pt;
-        pt *= x;
+    for (auto it = poly.rbegin(); it != poly.rend(); it++) {
+        res = res * x + *it;
     }
     return res;
 }
 
+/****** Evaluation points ******/
+
+/**
+ * The evaluation points (1, ..., N) used throughout the protocols
+ */
+template <int k, std::size_t N>
+const std::array<GF2k<k>, N>& evaluation_points() {
+    static const std::array<GF2k<k>, N> points = []() {
+        std::array<GF2k<k>, N> res;
+        for (std::size_t i = 0; i < N; i++) res[i] = GF2k<k>(i + 1);
+        return res;
+    }();
+    return points;
+}
+
+/**
+ * The evaluation points (1, ..., N) of GF(2^k2), lifted into GF(2^k)
+ */
+template <int k2, int k, std::size_t N>
+const std::array<GF2k<k>, N>& lifted_evaluation_points() {
+    static const std::array<GF2k<k>, N> points = []() {
+        std::array<GF2k<k>, N> res;
+        for (std::size_t i = 0; i < N; i++) res[i] = liftGF<k>(GF2k<k2>(i + 1));
+        return res;
+    }();
+    return points;
+}
+
+namespace detail {
+    /**
+     * Vandermonde matrix: powers[i][j] = xcoords[i]^j for j < L
+     */
+    template <std::size_t L, int k, std::size_t N>
+    std::array<std::array<GF2k<k>, L>, N> vandermonde(const std::array<GF2k<k>, N>& xcoords) {
+        std::array<std::array<GF2k<k>, L>, N> powers;
+        for (std::size_t i = 0; i < N; i++) {
+            // Even powers by squaring
+            powers[i][0] = GF2k<k>(1);
+            for (std::size_t j = 1; j < L; j++) {
+                powers[i][j] = (j % 2 == 0) ? powers[i][j / 2].square() : powers[i][j - 1] * xcoords[i];
+            }
+        }
+        return powers;
+    }
+
+    /**
+     * Evaluate `message` in all points of which `powers` holds (at least D+1) powers
+     */
+    template <int D, int k, std::size_t L, std::size_t N>
+    std::array<GF2k<k>, N> encode_with_powers(const std::array<std::array<GF2k<k>, L>, N>& powers, const std::array<GF2k<k>, D+1>& message) {
+        static_assert(L >= D + 1, "Not enough powers for the degree");
+        std::array<GF2k<k>, N> res;
+        for (std::size_t i = 0; i < N; i++) {
+            res[i] = batch::dot(powers[i].data(), message.data(), D + 1);
+        }
+        return res;
+    }
+
+    /**
+     * Whether the additive FFT beats a dot product with the precomputed powers, for encoding in (1, ..., N)
+     *
+     * The FFT costs about N log N products that each get reduced, the powers N * (D+1) lazily reduced ones.
+     * With the table based fields, the FFT wins once D+1 is around 4 log N, as for a large committee;
+     *  with carryless multiplication the reductions dominate and the powers stay faster for any practical N.
+     */
+    template <int D, int k, std::size_t N>
+    constexpr bool prefer_fft_encode() {
+        int log_n = 0;
+        while ((std::size_t(1) << log_n) < N + 1) log_n++;
+        return k <= 16 && D + 1 >= 4 * log_n;
+    }
+} // namespace detail
+
 /**
  * Encode a degree T polynomial by evaluating it in N points (1, ..., N)
  **/
 template <int D, int k, std::size_t N>
 std::array<GF2k<k>, N> encode(const std::array<GF2k<k>, D+1>& message) {
-    std::array<GF2k<k>, N> res;
-    for (std::size_t i = 1; i <= N; i++) {
-        res[i - 1] = poly_eval<D + 1, k>(message, GF2k<k>(i));
+    if constexpr (detail::prefer_fft_encode<D, k, N>()) {
+        return additive_fft<k>().template encode<D, N>(message);
+    } else {
+        static const auto powers = detail::vandermonde<D + 1>(evaluation_points<k, N>());
+        return detail::encode_with_powers<D>(powers, message);
     }
-    return res;
 }
 
 /**
@@ -97,8 +177,14 @@ std::array<GF2k<k>, N> encode(const std::array<GF2k<k>, D+1>& message) {
 template <int D, int k, std::size_t N>
 std::array<GF2k<k>, N> encode(const std::array<GF2k<k>, N>& xcoords, const std::array<GF2k<k>, D+1>& message) {
     std::array<GF2k<k>, N> res;
-    for (std::size_t i = 0; i < N; i++) {
-        res[i] = poly_eval<D + 1, k>(message, xcoords[i]);
+    if constexpr (D + 1 >= detail::SUBPRODUCT_EVALUATION_THRESHOLD) {
+        auto values = SubproductTree<k>(std::vector<GF2k<k>>(xcoords.begin(), xcoords.end()))
+            .evaluate(std::vector<GF2k<k>>(message.begin(), message.end()));
+        std::copy(values.begin(), values.end(), res.begin());
+    } else {
+        for (std::size_t i = 0; i < N; i++) {
+            res[i] = poly_eval<D + 1, k>(message, xcoords[i]);
+        }
     }
     return res;
 }
@@ -155,9 +241,20 @@ namespace detail {
 
 /****** Decoder(s) ******/
 
+/**
+ * Error correction algorithms, selected through a template parameter of the decoders
+ */
+// Solves a dense linear system, O(N^3)
+struct BerlekampWelch {};
+// Partial extended Euclid on the interpolating polynomial, O(N^2); suited for large committees
+struct Gao {};
+
 namespace detail {
+    /**
+     * Berlekamp-Welch, with `powers` the first D+E+1 powers of every evaluation point
+     */
     template <int D, int E, int k, std::size_t N>
-    std::array<GF2k<k>, D+1> berlekamp_welch(const std::array<GF2k<k>, N>& xcoords, const std::array<GF2k<k>, N>& shares) {
+    std::array<GF2k<k>, D+1> berlekamp_welch(const std::array<std::array<GF2k<k>, D + E + 1>, N>& powers, const std::array<GF2k<k>, N>& shares) {
         // deg(f2) = E
         // deg(f1/f2) = def(f1) - def(f2) = D
         // => deg(f1) = D + E
@@ -166,18 +263,16 @@ namespace detail {
         std::array<std::array<GF2k<k>, D + 2*E + 1>, D + 2*E + 1> M;
         std::array<GF2k<k>, D + 2*E + 1> y;
         for (int i = 0; i < D + 2*E + 1; i++) {
+            const auto& pows = powers[i];
+
             // Coefficients of f1(x)
-            GF2k<k> a(1);
             for (int j = 0; j < D + E + 1; j++) {
-                M[i][j] = a;
-                a *= xcoords[i];
+                M[i][j] = pows[j];
             }
             
             // Coefficients of f2(x); f2(0) = 1
-            a = GF2k<k>(1);
             for (int j = D + E + 1; j < D + 2*E + 1; j++) {
-                a *= xcoords[i];
-                M[i][j] = shares[i] * a;
+                M[i][j] = shares[i] * pows[j - D - E];
             }
 
             
@@ -196,83 +291,564 @@ namespace detail {
         return poly_div<D + E + 1, E + 1, k>(f1, f2);
     }
 
-    template <int k>
-    GF2k<k> lagrange_l(const std::int64_t& lo, const std::int64_t& hi, const std::int64_t& j, GF2k<k> x) {
-        GF2k<k> res{1};
-        GF2k<k> denom{1};
-        GF2k<k> el_j{j};
-        for (std::int64_t m = lo; m < hi; m++) {
-            if (m == j) continue;
-            GF2k<k> el_m{m};
-            res *= (x - el_m);
-            denom *= (el_j - el_m);
-        }
-        return res * denom.inv();
+    template <int D, int E, int k, std::size_t N>
+    std::array<GF2k<k>, D+1> berlekamp_welch(const std::array<GF2k<k>, N>& xcoords, const std::array<GF2k<k>, N>& shares) {
+        return berlekamp_welch<D, E>(vandermonde<D + E + 1>(xcoords), shares);
+    }
+
+    // Degree of a polynomial, -1 for the zero polynomial
+    template <int k, std::size_t L>
+    int degree(const std::array<GF2k<k>, L>& poly) {
+        for (int i = L - 1; i >= 0; i--) {
+            if (poly[i] != GF2k<k>(0)) return i;
+        }
+        return -1;
+    }
+
+    /**
+     * Gao's decoding algorithm, see "A New Algorithm for Decoding Reed-Solomon Codes" (Gao, 2003)
+     *
+     *  - interpolate g1 through all shares and let g0 = prod (X - x_i)
+     *  - run the extended Euclidean algorithm on (g0, g1) until the remainder g has degree < (N + D + 1) / 2,
+     *     with v the cofactor of g1
+     *  - the message is g / v, which has to divide exactly
+     *
+     * Only the first `n` points are used, correcting up to (n - D - 1) / 2 errors
+     */
+    template <int D, int k, std::size_t N>
+    std::array<GF2k<k>, D+1> gao_first(const std::array<GF2k<k>, N>& xcoords, const std::array<GF2k<k>, N>& shares, std::size_t n) {
+        assert(n <= N);
+        using Poly = std::array<GF2k<k>, N + 1>;
+
+        Poly g0{GF2k<k>(0)};
+        g0[0] = GF2k<k>(1);
+        for (std::size_t i = 0; i < n; i++) {
+            for (std::size_t j = i + 1; j > 0; j--) g0[j] = g0[j - 1] - xcoords[i] * g0[j];
+            g0[0] = xcoords[i] * g0[0]; // -x_i == x_i in characteristic 2
+        }
+
+        // Lagrange interpolation, with prod_{m != i} (x_i - x_m) = g0'(x_i); only odd powers survive the derivative
+        std::array<GF2k<k>, N> derivative{GF2k<k>(0)};
+        for (std::size_t j = 1; j <= n; j += 2) derivative[j - 1] = g0[j];
+        std::vector<GF2k<k>> weights(n);
+        for (std::size_t i = 0; i < n; i++) weights[i] = poly_eval(derivative, xcoords[i]);
+        batch::inv(weights);
+        Poly g1{GF2k<k>(0)};
+        for (std::size_t i = 0; i < n; i++) {
+            // Synthetic division g0 / (X - x_i)
+            GF2k<k> w = weights[i] * shares[i];
+            GF2k<k> q = g0[n];
+            for (std::size_t j = n; j-- > 0;) {
+                g1[j] += w * q;
+                q = g0[j] + xcoords[i] * q;
+            }
+        }
+
+        // Invariant: r_prev = u_prev * g0 + v_prev * g1 and r = u * g0 + v * g1
+        Poly r_prev = g0, r = g1;
+        Poly v_prev{GF2k<k>(0)}, v{GF2k<k>(0)};
+        v[0] = GF2k<k>(1);
+        int deg_r = degree(r);
+        while (2 * deg_r >= static_cast<int>(n) + D + 1) {
+            GF2k<k> lead_inv = r[deg_r].inv();
+            for (int deg_prev = degree(r_prev); deg_prev >= deg_r; deg_prev = degree(r_prev)) {
+                GF2k<k> c = r_prev[deg_prev] * lead_inv;
+                int shift = deg_prev - deg_r;
+                for (int j = 0; j <= deg_r; j++) r_prev[j + shift] -= c * r[j];
+                for (int j = 0; j + shift <= static_cast<int>(n); j++) v_prev[j + shift] -= c * v[j];
+            }
+            std::swap(r_prev, r);
+            std::swap(v_prev, v);
+            deg_r = degree(r);
+        }
+
+        // f = r / v
+        int deg_v = degree(v);
+        if (deg_r - deg_v > D) {
+            throw invalid_sharing("Output degree too large");
+        }
+        std::array<GF2k<k>, D+1> res{GF2k<k>(0)};
+        GF2k<k> lead_inv = v[deg_v].inv();
+        for (int i = deg_r - deg_v; i >= 0; i--) {
+            GF2k<k> c = r[i + deg_v] * lead_inv;
+            res[i] = c;
+            for (int j = 0; j <= deg_v; j++) r[i + j] -= c * v[j];
+        }
+        if (degree(r) >= 0) {
+            throw invalid_sharing("Non-zero remainder after polynomial division");
+        }
+        return res;
     }
 
+    template <int D, int E, int k, std::size_t N>
+    std::array<GF2k<k>, D+1> gao(const std::array<GF2k<k>, N>& xcoords, const std::array<GF2k<k>, N>& shares) {
+        static_assert(N >= D + 2*E + 1, "Cannot do error recovery with given parameters");
+        return gao_first<D>(xcoords, shares, N);
+    }
+
+    /**
+     * Coefficients of the Lagrange basis polynomials for the first D+1 points of `xcoords`:
+     *  basis[j][i] is the j-th coefficient of the polynomial that is 1 in xcoords[i] and 0 in the other points
+     */
+    template <int D, int k, std::size_t L>
+    std::array<std::array<GF2k<k>, D + 1>, D + 1> lagrange_basis(const std::array<GF2k<k>, L>& xcoords) {
+        static_assert(L >= D + 1, "Not enough points for the degree");
+        // Coefficients of P(X) = prod_{i <= D} (X - x_i)
+        std::array<GF2k<k>, D + 2> master{GF2k<k>(0)};
+        master[0] = GF2k<k>(1);
+        for (int i = 0; i <= D; i++) {
+            for (int j = i + 1; j > 0; j--) master[j] = master[j - 1] - xcoords[i] * master[j];
+            master[0] = xcoords[i] * master[0]; // -x_i == x_i in characteristic 2
+        }
+
+        // P(X) / (X - x_i), normalized in x_i
+        std::array<std::array<GF2k<k>, D + 1>, D + 1> basis;
+        std::vector<GF2k<k>> denom(D + 1);
+        for (int i = 0; i <= D; i++) {
+            std::array<GF2k<k>, D + 1> quotient;
+            quotient[D] = master[D + 1];
+            for (int j = D; j > 0; j--) quotient[j - 1] = master[j] + xcoords[i] * quotient[j];
+            for (int j = 0; j <= D; j++) basis[j][i] = quotient[j];
+            denom[i] = poly_eval(quotient, xcoords[i]);
+        }
+        batch::inv(denom);
+        for (int j = 0; j <= D; j++) {
+            for (int i = 0; i <= D; i++) basis[j][i] *= denom[i];
+        }
+        return basis;
+    }
+
+    template <int D, int E, int k, std::size_t N>
+    std::array<GF2k<k>, D+1> correct_errors(BerlekampWelch,
+            const std::array<GF2k<k>, N>& /* xcoords */,
+            const std::array<std::array<GF2k<k>, D + E + 1>, N>& powers,
+            const std::array<GF2k<k>, N>& shares) {
+        return berlekamp_welch<D, E>(powers, shares);
+    }
+
+    template <int D, int E, int k, std::size_t N>
+    std::array<GF2k<k>, D+1> correct_errors(Gao,
+            const std::array<GF2k<k>, N>& xcoords,
+            const std::array<std::array<GF2k<k>, D + E + 1>, N>& /* powers */,
+            const std::array<GF2k<k>, N>& shares) {
+        return gao<D, E>(xcoords, shares);
+    }
+
+} // namespace detail
+
+/**
+ * Lagrange interpolation in barycentric form, for a fixed set of (distinct) points
+ *
+ * The weights w_i = 1 / prod_{m != i} (x_i - x_m) cost O(n^2) once, with a single batch inversion;
+ *  afterwards every evaluation point only costs O(n)
+ */
+template <int k>
+class Barycentric {
+    public:
+        explicit Barycentric(std::vector<GF2k<k>> xcoords) : m_xcoords(std::move(xcoords)), m_weights(m_xcoords.size(), GF2k<k>(1)) {
+            std::size_t n = m_xcoords.size();
+            if (n >= detail::SUBPRODUCT_WEIGHTS_THRESHOLD) {
+                m_weights = SubproductTree<k>(m_xcoords).barycentric_weights();
+                return;
+            }
+            for (std::size_t i = 0; i < n; i++) {
+                for (std::size_t m = i + 1; m < n; m++) {
+                    GF2k<k> d = m_xcoords[i] - m_xcoords[m]; // == m_xcoords[m] - m_xcoords[i] in characteristic 2
+                    m_weights[i] *= d;
+                    m_weights[m] *= d;
+                }
+            }
+            batch::inv(m_weights);
+        }
+
+        /**
+         * The points (0, ..., npoints - 1)
+         */
+        explicit Barycentric(unsigned npoints) : Barycentric([npoints]() {
+            assert(npoints <= (1ull << std::min(k, 63)));
+            std::vector<GF2k<k>> xcoords;
+            xcoords.reserve(npoints);
+            for (unsigned i = 0; i < npoints; i++) xcoords.emplace_back(i);
+            return xcoords;
+        }()) {}
+
+        std::size_t size() const { return m_xcoords.size(); }
+
+        /**
+         * All Lagrange basis polynomials, evaluated in `x`
+         *
+         * l_i(x) = w_i * prod_{m != i} (x - x_m), from prefix and suffix products so that x may be one of the points
+         */
+        std::vector<GF2k<k>> coefficients(GF2k<k> x) const {
+            std::size_t n = m_xcoords.size();
+            std::vector<GF2k<k>> res(n);
+            GF2k<k> prefix(1);
+            for (std::size_t i = 0; i < n; i++) {
+                res[i] = prefix;
+                prefix *= x - m_xcoords[i];
+            }
+            GF2k<k> suffix(1);
+            for (std::size_t i = n; i-- > 0;) {
+                res[i] *= suffix * m_weights[i];
+                suffix *= x - m_xcoords[i];
+            }
+            return res;
+        }
+
+        /**
+         * The polynomial through the values `ys` in the points, evaluated in `x`
+         */
+        GF2k<k> evaluate(ConstGFSpan<k> ys, GF2k<k> x) const {
+            assert(ys.size() == size());
+            return batch::dot(ys.data(), coefficients(x).data(), ys.size());
+        }
+
+    private:
+        std::vector<GF2k<k>> m_xcoords;
+        std::vector<GF2k<k>> m_weights;
+};
+
+namespace detail {
+    /**
+     * All Lagrange basis polynomials for the (distinct) points `xcoords`, evaluated in `x`
+     */
     template <int k>
-    GF2k<k> lagrange_l(const std::vector<GF2k<k>>& xcoords, GF2k<k> coord, GF2k<k> x) {
-        GF2k<k> res{1};
-        GF2k<k> denom{1};
-        for (const auto& m : xcoords) {
-            if (m == coord) continue;
-            res *= (x - m);
-            denom *= (coord - m);
-        }
-        return res * denom.inv();
+    std::vector<GF2k<k>> lagrange_coefficients(const std::vector<GF2k<k>>& xcoords, GF2k<k> x) {
+        return Barycentric<k>(xcoords).coefficients(x);
     }
 } // namespace detail
 
+/**
+ * Result of decoding many sharings at once
+ */
+template <int k>
+struct BatchDecoding {
+    // The secret (constant coefficient) of every sharing, in order
+    GFVector<k> secrets;
+    // For every sharing that needed error correction: its index and the cheating parties
+    std::vector<std::pair<std::size_t, std::vector<int>>> cheaters;
+};
+
+/**
+ * Decoder for degree D polynomials from N shares in fixed points `xcoords`, correcting up to E errors
+ *
+ * All tables depending only on the points (Vandermonde powers, Lagrange weights and the parity checks)
+ *  are computed once, at construction.
+ *
+ * In the honest case, all shares lie on a single polynomial. The decoder first interpolates from the first D+1 shares
+ * and checks the other N-D-1 shares against precomputed Lagrange weights (a parity check on the codeword).
+ * Only when that syndrome is non-zero does it fall back to `Algorithm` (BerlekampWelch or Gao) to correct the errors.
+ */
+template <int D, int E, int k, std::size_t N, typename Algorithm = BerlekampWelch>
+class Decoder {
+    static_assert(N > D + 2*E, "Cannot do error recovery with given parameters");
+    static constexpr std::size_t CHECKS = N - D - 1;
+
+    public:
+        /**
+         * If `fft` is given, `xcoords` must be its points (1, ..., N); encode then uses it where that is faster
+         */
+        explicit Decoder(const std::array<GF2k<k>, N>& xcoords, const AdditiveFFT<k>* fft = nullptr)
+            : m_xcoords(xcoords), m_fft(fft), m_powers(detail::vandermonde<D + E + 1>(xcoords)), m_interp(detail::lagrange_basis<D>(xcoords)) {
+
+            // Every other share should be the interpolation of the first D+1 ones in its point
+            Barycentric<k> base(std::vector<GF2k<k>>(xcoords.begin(), xcoords.begin() + D + 1));
+            for (std::size_t r = 0; r < CHECKS; r++) {
+                auto weights = base.coefficients(xcoords[D + 1 + r]);
+                std::copy(weights.begin(), weights.end(), m_check[r].begin());
+            }
+        }
+
+        /**
+         * Decode the N shares (in order) back into the original polynomial
+         * Also indicate a set of cheating parties
+         *
+         * Throws invalid_sharing if this cannot be done
+         **/
+        std::pair<std::array<GF2k<k>, D + 1>, std::vector<int>> decode(const std::array<GF2k<k>, N>& shares) const {
+            if (consistent(shares)) {
+                return {interpolate(shares), {}};
+            }
+
+            auto poly = detail::correct_errors<D, E>(Algorithm{}, m_xcoords, m_powers, shares);
+            auto recovered = encode(poly);
+            std::vector<int> cheaters;
+            for (std::size_t i = 0; i < N; i++) {
+                if (shares[i] != recovered[i]) {
+                    cheaters.push_back(i + 1);
+                }
+            }
+            return {poly, cheaters};
+        }
+
+        /**
+         * Decode while ignoring the shares of the parties in `erased` (numbered from 1, like the cheaters),
+         *  e.g. parties that were caught cheating before
+         *
+         * An erasure costs a single share of redundancy, where an unknown error costs two:
+         *  with e erasures, up to (N - e - D - 1) / 2 errors among the other shares are still corrected.
+         * The erasures are only used while that still covers E errors, see erasable(); otherwise, or when decoding
+         *  without the erased shares fails, all N shares are decoded as usual.
+         * The reported cheaters never include the erased parties.
+         *
+         * Throws invalid_sharing if this cannot be done
+         **/
+        std::pair<std::array<GF2k<k>, D + 1>, std::vector<int>> decode(const std::array<GF2k<k>, N>& shares, const std::vector<int>& erased) const {
+            if (erased.empty()) return decode(shares);
+            if (erasable(erased)) {
+                try {
+                    return decode_remaining(shares, erased);
+                } catch (const invalid_sharing&) {
+                    // Too many errors among the remaining shares, the erased ones may still help
+                }
+            }
+
+            auto [poly, cheaters] = decode(shares);
+            cheaters.erase(std::remove_if(cheaters.begin(), cheaters.end(), [&](int c) {
+                return std::find(erased.begin(), erased.end(), c) != erased.end();
+            }), cheaters.end());
+            return {poly, cheaters};
+        }
+
+        /**
+         * Whether erasing the parties in `erased` still leaves enough shares to correct E errors:
+         *  at most E parties are erased, and at least D + 1 + 2E shares remain
+         */
+        bool erasable(const std::vector<int>& erased) const {
+            return erased.size() <= static_cast<std::size_t>(E) && N - erased.size() >= static_cast<std::size_t>(D + 1 + 2*E);
+        }
+
+        /**
+         * Decode many sharings at once, from a column-major (sharings x N) matrix:
+         *  shares[j * count + s] is the share of party j + 1 in sharing s
+         *
+         * The syndromes of all sharings are computed in a single pass over the matrix, and only the sharings with
+         *  a non-zero syndrome go through error correction.
+         *
+         * With `erased` parties, their columns are left out of the pass and of the error correction, as far as
+         *  decode(shares, erased) would leave them out
+         *
+         * Throws invalid_sharing if any of the sharings cannot be decoded
+         **/
+        BatchDecoding<k> decode_batch(ConstGFSpan<k> shares, const std::vector<int>& erased = {}) const {
+            assert(shares.size() % N == 0);
+            std::size_t count = shares.size() / N;
+
+            // A single pass over all columns; every syndrome and secret is reduced only once
+            BatchDecoding<k> res{GFVector<k>(count), {}};
+            std::vector<bool> flagged;
+            if (erased.empty() || !erasable(erased)) {
+                std::array<std::size_t, N> columns;
+                for (std::size_t i = 0; i < N; i++) columns[i] = i;
+                flagged = syndrome_pass(shares, count, columns.data(), m_interp[0], m_check, res.secrets);
+            } else {
+                const auto& subset = remaining(erased);
+                flagged = syndrome_pass(shares, count, subset.columns.data(), subset.interp[0], subset.checks, res.secrets);
+            }
+
+            for (std::size_t s = 0; s < count; s++) {
+                if (!flagged[s]) continue;
+                std::array<GF2k<k>, N> single;
+                for (std::size_t j = 0; j < N; j++) single[j] = shares[j * count + s];
+                auto [poly, cheaters] = decode(single, erased);
+                res.secrets[s] = poly[0];
+                if (!cheaters.empty()) res.cheaters.emplace_back(s, std::move(cheaters));
+            }
+            return res;
+        }
+
+        /**
+         * Evaluate the degree D polynomial `message` in all points
+         */
+        std::array<GF2k<k>, N> encode(const std::array<GF2k<k>, D + 1>& message) const {
+            if constexpr (detail::prefer_fft_encode<D, k, N>()) {
+                if (m_fft) return m_fft->template encode<D, N>(message);
+            }
+            return detail::encode_with_powers<D>(m_powers, message);
+        }
+
+        /**
+         * The polynomial through the first D+1 shares, without any consistency check
+         */
+        std::array<GF2k<k>, D + 1> interpolate(const std::array<GF2k<k>, N>& shares) const {
+            std::array<GF2k<k>, D + 1> poly;
+            for (int j = 0; j <= D; j++) poly[j] = batch::dot(m_interp[j].data(), shares.data(), D + 1);
+            return poly;
+        }
+
+        /**
+         * Whether all shares lie on a single polynomial of degree at most D, i.e. the syndrome is zero
+         */
+        bool consistent(const std::array<GF2k<k>, N>& shares) const {
+            for (std::size_t r = 0; r < CHECKS; r++) {
+                if (batch::dot(m_check[r].data(), shares.data(), D + 1) != shares[D + 1 + r]) return false;
+            }
+            return true;
+        }
+
+    private:
+        /**
+         * Decode from the shares of the parties not in `erased` alone
+         */
+        std::pair<std::array<GF2k<k>, D + 1>, std::vector<int>> decode_remaining(const std::array<GF2k<k>, N>& shares, const std::vector<int>& erased) const {
+            const auto& subset = remaining(erased);
+            std::size_t n = subset.columns.size();
+            std::array<GF2k<k>, N> ys;
+            for (std::size_t i = 0; i < n; i++) ys[i] = shares[subset.columns[i]];
+
+            // Honest case: the remaining shares lie on the polynomial through the first D+1 of them
+            std::array<GF2k<k>, D + 1> poly;
+            for (int j = 0; j <= D; j++) poly[j] = batch::dot(subset.interp[j].data(), ys.data(), D + 1);
+            bool consistent = true;
+            for (std::size_t r = 0; r < subset.checks.size() && consistent; r++) {
+                consistent = batch::dot(subset.checks[r].data(), ys.data(), D + 1) == ys[D + 1 + r];
+            }
+            if (consistent) return {poly, {}};
+
+            poly = detail::gao_first<D>(subset.xcoords, ys, n);
+            std::vector<int> cheaters;
+            for (std::size_t i = 0; i < n; i++) {
+                if (poly_eval(poly, subset.xcoords[i]) != ys[i]) {
+                    cheaters.push_back(subset.columns[i] + 1);
+                }
+            }
+            return {poly, cheaters};
+        }
+
+        /**
+         * The tables for decoding from the shares of the parties that are not erased
+         */
+        struct Subset {
+            // Indices of the remaining shares, and their points compacted to the front
+            std::vector<std::size_t> columns;
+            std::array<GF2k<k>, N> xcoords;
+            // Like m_interp and m_check, on the first D+1 remaining shares
+            std::array<std::array<GF2k<k>, D + 1>, D + 1> interp;
+            std::vector<std::array<GF2k<k>, D + 1>> checks;
+        };
+
+        /**
+         * The tables for the parties not in `erased`, built the first time this set is seen
+         * The same few parties usually stay erased for a whole session, so those are worth keeping
+         */
+        const Subset& remaining(const std::vector<int>& erased) const {
+            std::vector<std::size_t> columns;
+            for (std::size_t i = 0; i < N; i++) {
+                if (std::find(erased.begin(), erased.end(), static_cast<int>(i + 1)) == erased.end()) columns.push_back(i);
+            }
+            if (columns.size() < D + 1) {
+                throw invalid_sharing("Too many erasures to decode");
+            }
+
+            std::lock_guard<std::mutex> lock(m_subsets_mutex);
+            auto it = m_subsets.find(columns);
+            if (it != m_subsets.end()) return it->second;
+
+            Subset subset;
+            subset.columns = columns;
+            for (std::size_t i = 0; i < columns.size(); i++) subset.xcoords[i] = m_xcoords[columns[i]];
+            subset.interp = detail::lagrange_basis<D>(subset.xcoords);
+            Barycentric<k> base(std::vector<GF2k<k>>(subset.xcoords.begin(), subset.xcoords.begin() + D + 1));
+            for (std::size_t i = D + 1; i < columns.size(); i++) {
+                auto weights = base.coefficients(subset.xcoords[i]);
+                subset.checks.emplace_back();
+                std::copy(weights.begin(), weights.end(), subset.checks.back().begin());
+            }
+            return m_subsets.emplace(std::move(columns), std::move(subset)).first->second;
+        }
+
+        /**
+         * Fill in the secrets of all sharings from the first D+1 of `columns`,
+         *  and flag the ones whose other columns fail one of the `checks`
+         */
+        template <typename Checks>
+        std::vector<bool> syndrome_pass(ConstGFSpan<k> shares, std::size_t count, const std::size_t* columns,
+                const std::array<GF2k<k>, D + 1>& secret_weights, const Checks& checks, GFVector<k>& secrets) const {
+            std::vector<bool> flagged(count, false);
+            for (std::size_t s = 0; s < count; s++) {
+                GF2kAccumulator<k> secret;
+                for (int i = 0; i <= D; i++) secret.add_product(secret_weights[i], shares[columns[i] * count + s]);
+                secrets[s] = secret.reduce();
+
+                for (std::size_t r = 0; r < checks.size(); r++) {
+                    GF2kAccumulator<k> syndrome;
+                    syndrome.add(shares[columns[D + 1 + r] * count + s]);
+                    for (int i = 0; i <= D; i++) syndrome.add_product(checks[r][i], shares[columns[i] * count + s]);
+                    if (syndrome.reduce() != GF2k<k>(0)) {
+                        flagged[s] = true;
+                        break;
+                    }
+                }
+            }
+            return flagged;
+        }
+
+        std::array<GF2k<k>, N> m_xcoords;
+        const AdditiveFFT<k>* m_fft;
+        // m_powers[i][j] = m_xcoords[i]^j
+        std::array<std::array<GF2k<k>, D + E + 1>, N> m_powers;
+        // m_interp[j] holds the weights of the first D+1 shares in the j-th coefficient
+        std::array<std::array<GF2k<k>, D + 1>, D + 1> m_interp;
+        // m_check[r] holds the weights of the first D+1 shares in point D+1+r
+        std::array<std::array<GF2k<k>, D + 1>, CHECKS> m_check;
+        // Tables per set of remaining parties, see remaining()
+        mutable std::map<std::vector<std::size_t>, Subset> m_subsets;
+        mutable std::mutex m_subsets_mutex;
+};
+
 /**
  * Decode a collection of N shares (in order) back into the original polynomial
  * Also indicate a set of cheating parties
  *
+ * Prefer keeping a Decoder around when decoding repeatedly with the same `xcoords`
+ *
  * Throws invalid_sharing if this cannot be done
  **/
-template <int D, int E, int k, std::size_t N>
+template <int D, int E, typename Algorithm = BerlekampWelch, int k, std::size_t N>
 std::pair<std::array<GF2k<k>, D + 1>, std::vector<int>> decode(const std::array<GF2k<k>, N>& xcoords, const std::array<GF2k<k>, N>& shares) {
-    static_assert(N > D + 2*E, "Cannot do error recovery with given parameters");
-    auto poly = detail::berlekamp_welch<D, E>(xcoords, shares);
-    auto recovered = encode<D, k, N>(xcoords, poly);
-    std::vector<int> cheaters;
-    for (std::size_t i = 0; i < N; i++) {
-        if (shares[i] != recovered[i]) {
-            cheaters.push_back(i + 1);
-        }
-    }
-    return {poly, cheaters};
+    return Decoder<D, E, k, N, Algorithm>(xcoords).decode(shares);
 }
 
-template <int D, int E, int k, std::size_t N>
-std::pair<std::array<GF2k<k>, D + 1>, std::vector<int>> decode(const std::array<GF2k<k>, N>& shares) {
-    static_assert(N > D + 2*E, "Cannot do error recovery with given parameters");
+/**
+ * The decoder for shares in points (1, ..., N)
+ **/
+template <int D, int E, int k, std::size_t N, typename Algorithm = BerlekampWelch>
+const Decoder<D, E, k, N, Algorithm>& default_decoder() {
+    static const Decoder<D, E, k, N, Algorithm> decoder(evaluation_points<k, N>(), &additive_fft<k>());
+    return decoder;
+}
 
-    static bool xcoords_init = false;
-    static std::array<GF2k<k>, N> xcoords;
-    if (!xcoords_init) {
-        for (std::size_t i = 0; i < N; i++) xcoords[i] = GF2k<k>(i + 1);
-        xcoords_init = true;
-    }
+/**
+ * The decoder for shares in the points (1, ..., N) of GF(2^k2), lifted into GF(2^k)
+ **/
+template <int D, int E, int k2, int k, std::size_t N, typename Algorithm = BerlekampWelch>
+const Decoder<D, E, k, N, Algorithm>& lifted_decoder() {
+    static const Decoder<D, E, k, N, Algorithm> decoder(lifted_evaluation_points<k2, k, N>());
+    return decoder;
+}
 
-    auto poly = detail::berlekamp_welch<D, E>(xcoords, shares);
-    auto recovered = encode<D, k, N>(xcoords, poly);
-    std::vector<int> cheaters;
-    for (std::size_t i = 0; i < N; i++) {
-        if (shares[i] != recovered[i]) {
-            cheaters.push_back(i + 1);
-        }
-    }
-    return {poly, cheaters};
+/**
+ * Same, for the shares in points (1, ..., N)
+ **/
+template <int D, int E, typename Algorithm = BerlekampWelch, int k, std::size_t N>
+std::pair<std::array<GF2k<k>, D + 1>, std::vector<int>> decode(const std::array<GF2k<k>, N>& shares) {
+    return default_decoder<D, E, k, N, Algorithm>().decode(shares);
 }
 
-template <int k>
-GF2k<k> interpolate(const std::vector<GF2k<k>>& ys, const GF2k<k>& x) {
-    assert(ys.size() < (1ull << std::min(k, 63)));
-    GF2k<k> res{0};
-    for (std::size_t i = 0; i < ys.size(); i++) {
-        res += ys[i] * detail::lagrange_l<k>(0, ys.size(), i, x);
-    }
-    return res;
+/**
+ * Same, ignoring the shares of the `erased` parties, see Decoder::decode
+ **/
+template <int D, int E, typename Algorithm = BerlekampWelch, int k, std::size_t N>
+std::pair<std::array<GF2k<k>, D + 1>, std::vector<int>> decode(const std::array<GF2k<k>, N>& shares, const std::vector<int>& erased) {
+    return default_decoder<D, E, k, N, Algorithm>().decode(shares, erased);
+}
+
+/**
+ * Decode a column-major (sharings x N) matrix of shares in points (1, ..., N), see Decoder::decode_batch
+ **/
+template <int D, int E, int N, int k, typename Algorithm = BerlekampWelch>
+BatchDecoding<k> decode_batch(ConstGFSpan<k> shares, const std::vector<int>& erased = {}) {
+    return default_decoder<D, E, k, N, Algorithm>().decode_batch(shares, erased);
 }
 
 template <int k>
@@ -298,47 +874,45 @@ std::vector<GF2k<k>> interpolate_preprocess(const std::vector<GF2k<k>>& xcoords,
     //      O(1) preprocessing (none, really)
     //    + O(n1 * (n2 + ρ)^3) evaluation (num interpolations * build/eval polynomial * inner product)
     
-    std::vector<GF2k<k>> res;
-    res.reserve(xcoords.size());
-    for (GF2k<k> coord : xcoords) {
-        res.push_back(detail::lagrange_l<k>(xcoords, coord, x));
-    }
-    return res;
+    return detail::lagrange_coefficients(xcoords, x);
 }
 
 template <int k>
 std::vector<GF2k<k>> interpolate_preprocess(unsigned npoints, GF2k<k> x) {
-    assert(npoints < (1ull << std::min(k, 63)));
-    std::vector<GF2k<k>> res;
-    for (int i = 0; i < npoints; i++) {
-        res.emplace_back(detail::lagrange_l<k>(0, npoints, i, x));
-    }
-    return res;
+    return Barycentric<k>(npoints).coefficients(x);
+}
+
+/**
+ * Evaluate the polynomial through `ys` in the points (0, ..., ys.size() - 1) in `x`
+ * Use a Barycentric directly when interpolating in the same points more than once
+ */
+template <int k>
+GF2k<k> interpolate(const std::vector<GF2k<k>>& ys, const GF2k<k>& x) {
+    return Barycentric<k>(ys.size()).evaluate(ys, x);
 }
 
 template <int k>
 GF2k<k> interpolate_with_preprocessing(const std::vector<GF2k<k>>& preprocessing, const std::vector<GF2k<k>>& ys) {
     assert(ys.size() == preprocessing.size());
-    GF2k<k> res{0};
-    for (std::size_t i = 0; i < ys.size(); i++) {
-        res += ys[i] * preprocessing[i];
-    }
-    return res;
+    return batch::dot(ys, preprocessing);
 }
 
+/**
+ * The coefficients of the polynomial through `vals` in the points (0, ..., N-1)
+ */
 template <unsigned long N, int k>
 std::array<GF2k<k>, N> interpolate_poly(const std::array<GF2k<k>, N>& vals) {
-    static_assert(N == 2, "Can currently only handle interpolation on 2 points"); // TODO: improve
-    return {vals[0], vals[1] - vals[0]};
-}
-
-template <unsigned long N1, unsigned long N2, int k>
-std::array<GF2k<k>, N1+N2 - 1> poly_mul(const std::array<GF2k<k>, N1>& x, const std::array<GF2k<k>, N2>& y) {
-    std::array<GF2k<k>, N1+N2-1> res{GF2k<k>{0}};
-    for (unsigned long i = 0; i < N1; i++) {
-        for (unsigned long j = 0; j < N2; j++) {
-            res[i + j] += x[i] * y[j];
-        }
+    if constexpr (N == 2) {
+        return {vals[0], vals[1] - vals[0]};
+    } else {
+        static const auto basis = detail::lagrange_basis<N - 1>([]() {
+            std::array<GF2k<k>, N> xcoords;
+            for (unsigned long i = 0; i < N; i++) xcoords[i] = GF2k<k>(i);
+            return xcoords;
+        }());
+        std::array<GF2k<k>, N> poly;
+        for (unsigned long j = 0; j < N; j++) poly[j] = batch::dot(basis[j].data(), vals.data(), N);
+        return poly;
     }
-    return res;
 }
+
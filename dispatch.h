@@ -0,0 +1,62 @@
+/*
+Copyright (c) 2022, COSIC-KU Leuven, Kasteelpark Arenberg 10, bus 2452, B-3001 Leuven-Heverlee, Belgium.
+
+All rights reserved
+*/
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "cpu-support.h"
+
+/**
+ * Instruction set variants of the hot kernels (field arithmetic and the PRNG)
+ *
+ *  - baseline: SSE4.1, PCLMULQDQ and AES-NI, what the project is compiled for
+ *  - avx2:     256-bit VPCLMULQDQ (and VAES when present)
+ *  - avx512:   512-bit VPCLMULQDQ (and VAES when present)
+ *
+ * The best variant the processor supports is selected once, at first use.
+ * Setting the environment variable FETA_ISA to one of the names above selects a lower one instead,
+ * e.g. for benchmarking or to rule out a kernel when debugging.
+ */
+enum class ISA { baseline = 0, avx2 = 1, avx512 = 2 };
+
+namespace detail {
+    // The CPUID feature bits alone are not enough: the OS must also save the wider registers (XCR0)
+    inline ISA detect_isa() {
+        if (cpu_has_vpclmul() && cpu_has_avx512f() && cpu_has_avx512bw() && os_has_zmm_state()) return ISA::avx512;
+        if (cpu_has_vpclmul() && cpu_has_avx2() && os_has_ymm_state()) return ISA::avx2;
+        return ISA::baseline;
+    }
+
+    inline ISA choose_isa() {
+        ISA best = detect_isa();
+        const char* requested_name = std::getenv("FETA_ISA");
+        if (requested_name == nullptr) return best;
+
+        ISA requested;
+        if (std::strcmp(requested_name, "baseline") == 0) {
+            requested = ISA::baseline;
+        } else if (std::strcmp(requested_name, "avx2") == 0) {
+            requested = ISA::avx2;
+        } else if (std::strcmp(requested_name, "avx512") == 0) {
+            requested = ISA::avx512;
+        } else {
+            std::cerr << "Ignoring unknown FETA_ISA=" << requested_name << std::endl;
+            return best;
+        }
+        if (static_cast<int>(requested) > static_cast<int>(best)) {
+            std::cerr << "FETA_ISA=" << requested_name << " is not supported by this processor, ignoring it" << std::endl;
+            return best;
+        }
+        return requested;
+    }
+} // namespace detail
+
+inline ISA selected_isa() {
+    static const ISA isa = detail::choose_isa();
+    return isa;
+}
@@ -4,320 +4,63 @@
 #include "gflifttables.h"
 
 namespace gflifttables {
-    template <> GF2k<66> lift_v<3, 66>[3];
-    template <> GF2k<69> lift_v<3, 69>[3];
-    template <> GF2k<72> lift_v<3, 72>[3];
-    template <> GF2k<75> lift_v<3, 75>[3];
-    template <> GF2k<78> lift_v<3, 78>[3];
-    template <> GF2k<81> lift_v<3, 81>[3];
-    template <> GF2k<84> lift_v<3, 84>[3];
-    template <> GF2k<87> lift_v<3, 87>[3];
-    template <> GF2k<90> lift_v<3, 90>[3];
-    template <> GF2k<93> lift_v<3, 93>[3];
-    template <> GF2k<96> lift_v<3, 96>[3];
-    template <> GF2k<99> lift_v<3, 99>[3];
-    template <> GF2k<102> lift_v<3, 102>[3];
-    template <> GF2k<105> lift_v<3, 105>[3];
-    template <> GF2k<108> lift_v<3, 108>[3];
-    template <> GF2k<111> lift_v<3, 111>[3];
-    template <> GF2k<114> lift_v<3, 114>[3];
-    template <> GF2k<117> lift_v<3, 117>[3];
-    template <> GF2k<120> lift_v<3, 120>[3];
-    template <> GF2k<123> lift_v<3, 123>[3];
-    template <> GF2k<126> lift_v<3, 126>[3];
-    template <> GF2k<68> lift_v<4, 68>[4];
-    template <> GF2k<72> lift_v<4, 72>[4];
-    template <> GF2k<76> lift_v<4, 76>[4];
-    template <> GF2k<80> lift_v<4, 80>[4];
-    template <> GF2k<84> lift_v<4, 84>[4];
-    template <> GF2k<88> lift_v<4, 88>[4];
-    template <> GF2k<92> lift_v<4, 92>[4];
-    template <> GF2k<96> lift_v<4, 96>[4];
-    template <> GF2k<100> lift_v<4, 100>[4];
-    template <> GF2k<104> lift_v<4, 104>[4];
-    template <> GF2k<108> lift_v<4, 108>[4];
-    template <> GF2k<112> lift_v<4, 112>[4];
-    template <> GF2k<116> lift_v<4, 116>[4];
-    template <> GF2k<120> lift_v<4, 120>[4];
-    template <> GF2k<124> lift_v<4, 124>[4];
-    template <> GF2k<128> lift_v<4, 128>[4];
-    template <> GF2k<65> lift_v<5, 65>[5];
-    template <> GF2k<70> lift_v<5, 70>[5];
-    template <> GF2k<75> lift_v<5, 75>[5];
-    template <> GF2k<80> lift_v<5, 80>[5];
-    template <> GF2k<85> lift_v<5, 85>[5];
-    template <> GF2k<90> lift_v<5, 90>[5];
-    template <> GF2k<95> lift_v<5, 95>[5];
-    template <> GF2k<100> lift_v<5, 100>[5];
-    template <> GF2k<105> lift_v<5, 105>[5];
-    template <> GF2k<110> lift_v<5, 110>[5];
-    template <> GF2k<115> lift_v<5, 115>[5];
-    template <> GF2k<120> lift_v<5, 120>[5];
-    template <> GF2k<125> lift_v<5, 125>[5];
-    template <> GF2k<70> lift_v<7, 70>[7];
-    template <> GF2k<77> lift_v<7, 77>[7];
-    template <> GF2k<84> lift_v<7, 84>[7];
-    template <> GF2k<91> lift_v<7, 91>[7];
-    template <> GF2k<98> lift_v<7, 98>[7];
-    template <> GF2k<105> lift_v<7, 105>[7];
-    template <> GF2k<112> lift_v<7, 112>[7];
-    template <> GF2k<119> lift_v<7, 119>[7];
-    template <> GF2k<126> lift_v<7, 126>[7];
-    void __attribute__((constructor)) init_gflifttables() {
-        lift_v<3, 66>[0] = GF2k<66>{detail::int128(1u, 0u)};
-        lift_v<3, 66>[1] = GF2k<66>{detail::int128(13590393859353636u, 0u)};
-        lift_v<3, 66>[2] = GF2k<66>{detail::int128(293888463537711412u, 0u)};
-        lift_v<3, 69>[0] = GF2k<69>{detail::int128(1u, 0u)};
-        lift_v<3, 69>[1] = GF2k<69>{detail::int128(3830885121293690020u, 6u)};
-        lift_v<3, 69>[2] = GF2k<69>{detail::int128(8065282976391997751u, 30u)};
-        lift_v<3, 72>[0] = GF2k<72>{detail::int128(1u, 0u)};
-        lift_v<3, 72>[1] = GF2k<72>{detail::int128(6336268284552524189u, 3u)};
-        lift_v<3, 72>[2] = GF2k<72>{detail::int128(5454517800467176933u, 75u)};
-        lift_v<3, 75>[0] = GF2k<75>{detail::int128(1u, 0u)};
-        lift_v<3, 75>[1] = GF2k<75>{detail::int128(15871649223786271521u, 377u)};
-        lift_v<3, 75>[2] = GF2k<75>{detail::int128(17505696889651349636u, 1496u)};
-        lift_v<3, 78>[0] = GF2k<78>{detail::int128(1u, 0u)};
-        lift_v<3, 78>[1] = GF2k<78>{detail::int128(6502690503150295118u, 3031u)};
-        lift_v<3, 78>[2] = GF2k<78>{detail::int128(16753331821363012292u, 11795u)};
-        lift_v<3, 81>[0] = GF2k<81>{detail::int128(1u, 0u)};
-        lift_v<3, 81>[1] = GF2k<81>{detail::int128(11258874081089016404u, 3950u)};
-        lift_v<3, 81>[2] = GF2k<81>{detail::int128(3016336880968184730u, 4999u)};
-        lift_v<3, 84>[0] = GF2k<84>{detail::int128(1u, 0u)};
-        lift_v<3, 84>[1] = GF2k<84>{detail::int128(10508740730572443884u, 211021u)};
-        lift_v<3, 84>[2] = GF2k<84>{detail::int128(3594861065436500213u, 678596u)};
-        lift_v<3, 87>[0] = GF2k<87>{detail::int128(1u, 0u)};
-        lift_v<3, 87>[1] = GF2k<87>{detail::int128(2120294475864440404u, 469302u)};
-        lift_v<3, 87>[2] = GF2k<87>{detail::int128(9753526937005453754u, 1145692u)};
-        lift_v<3, 90>[0] = GF2k<90>{detail::int128(1u, 0u)};
-        lift_v<3, 90>[1] = GF2k<90>{detail::int128(1297037243531132992u, 18464u)};
-        lift_v<3, 90>[2] = GF2k<90>{detail::int128(146371385952833544u, 8407044u)};
-        lift_v<3, 93>[0] = GF2k<93>{detail::int128(1u, 0u)};
-        lift_v<3, 93>[1] = GF2k<93>{detail::int128(6471350698447630505u, 147988550u)};
-        lift_v<3, 93>[2] = GF2k<93>{detail::int128(12993965911175122027u, 458075376u)};
-        lift_v<3, 96>[0] = GF2k<96>{detail::int128(1u, 0u)};
-        lift_v<3, 96>[1] = GF2k<96>{detail::int128(12380203306852414734u, 2050575828u)};
-        lift_v<3, 96>[2] = GF2k<96>{detail::int128(11809411057215125947u, 3445342820u)};
-        lift_v<3, 99>[0] = GF2k<99>{detail::int128(1u, 0u)};
-        lift_v<3, 99>[1] = GF2k<99>{detail::int128(16553231565667262187u, 8400290770u)};
-        lift_v<3, 99>[2] = GF2k<99>{detail::int128(4863381025399063222u, 16481804496u)};
-        lift_v<3, 102>[0] = GF2k<102>{detail::int128(1u, 0u)};
-        lift_v<3, 102>[1] = GF2k<102>{detail::int128(13734529408254840878u, 14640199126u)};
-        lift_v<3, 102>[2] = GF2k<102>{detail::int128(14661378571639946705u, 158640295145u)};
-        lift_v<3, 105>[0] = GF2k<105>{detail::int128(1u, 0u)};
-        lift_v<3, 105>[1] = GF2k<105>{detail::int128(12932104876947754886u, 64389323199u)};
-        lift_v<3, 105>[2] = GF2k<105>{detail::int128(12887872257600252478u, 1385286366046u)};
-        lift_v<3, 108>[0] = GF2k<108>{detail::int128(1u, 0u)};
-        lift_v<3, 108>[1] = GF2k<108>{detail::int128(17919953340050387491u, 2284999676742u)};
-        lift_v<3, 108>[2] = GF2k<108>{detail::int128(2369740915872716803u, 7971561826384u)};
-        lift_v<3, 111>[0] = GF2k<111>{detail::int128(1u, 0u)};
-        lift_v<3, 111>[1] = GF2k<111>{detail::int128(4026013208167156648u, 9733666548147u)};
-        lift_v<3, 111>[2] = GF2k<111>{detail::int128(5319828388765496942u, 91669938261748u)};
-        lift_v<3, 114>[0] = GF2k<114>{detail::int128(1u, 0u)};
-        lift_v<3, 114>[1] = GF2k<114>{detail::int128(4974558966096222435u, 74563717814626u)};
-        lift_v<3, 114>[2] = GF2k<114>{detail::int128(6816542800707707057u, 479821584398017u)};
-        lift_v<3, 117>[0] = GF2k<117>{detail::int128(1u, 0u)};
-        lift_v<3, 117>[1] = GF2k<117>{detail::int128(3366835236737827659u, 3245756357676900u)};
-        lift_v<3, 117>[2] = GF2k<117>{detail::int128(12594281500514882725u, 8958095230518815u)};
-        lift_v<3, 120>[0] = GF2k<120>{detail::int128(1u, 0u)};
-        lift_v<3, 120>[1] = GF2k<120>{detail::int128(1646115861088479006u, 22019381725979525u)};
-        lift_v<3, 120>[2] = GF2k<120>{detail::int128(653699091415738964u, 45965296981323646u)};
-        lift_v<3, 123>[0] = GF2k<123>{detail::int128(1u, 0u)};
-        lift_v<3, 123>[1] = GF2k<123>{detail::int128(7360865503288285761u, 254944352558692798u)};
-        lift_v<3, 123>[2] = GF2k<123>{detail::int128(8594649823352590475u, 440275925003152602u)};
-        lift_v<3, 126>[0] = GF2k<126>{detail::int128(1u, 0u)};
-        lift_v<3, 126>[1] = GF2k<126>{detail::int128(9223376434903384064u, 0u)};
-        lift_v<3, 126>[2] = GF2k<126>{detail::int128(4398048608257u, 1048576u)};
-        lift_v<4, 68>[0] = GF2k<68>{detail::int128(1u, 0u)};
-        lift_v<4, 68>[1] = GF2k<68>{detail::int128(12710093752160264630u, 11u)};
-        lift_v<4, 68>[2] = GF2k<68>{detail::int128(17386029479123132123u, 13u)};
-        lift_v<4, 68>[3] = GF2k<68>{detail::int128(15588548817824486596u, 3u)};
-        lift_v<4, 72>[0] = GF2k<72>{detail::int128(1u, 0u)};
-        lift_v<4, 72>[1] = GF2k<72>{detail::int128(17391388760111519088u, 34u)};
-        lift_v<4, 72>[2] = GF2k<72>{detail::int128(15612407915177394732u, 104u)};
-        lift_v<4, 72>[3] = GF2k<72>{detail::int128(4181693157959829933u, 7u)};
-        lift_v<4, 76>[0] = GF2k<76>{detail::int128(1u, 0u)};
-        lift_v<4, 76>[1] = GF2k<76>{detail::int128(11683891173972340330u, 20u)};
-        lift_v<4, 76>[2] = GF2k<76>{detail::int128(957076224813831542u, 476u)};
-        lift_v<4, 76>[3] = GF2k<76>{detail::int128(2873619389214706038u, 128u)};
-        lift_v<4, 80>[0] = GF2k<80>{detail::int128(1u, 0u)};
-        lift_v<4, 80>[1] = GF2k<80>{detail::int128(14738282592355353704u, 19838u)};
-        lift_v<4, 80>[2] = GF2k<80>{detail::int128(12461724952694633392u, 41594u)};
-        lift_v<4, 80>[3] = GF2k<80>{detail::int128(10386040542880409177u, 10790u)};
-        lift_v<4, 84>[0] = GF2k<84>{detail::int128(1u, 0u)};
-        lift_v<4, 84>[1] = GF2k<84>{detail::int128(11253100945281353594u, 150881u)};
-        lift_v<4, 84>[2] = GF2k<84>{detail::int128(4342481523985565120u, 861351u)};
-        lift_v<4, 84>[3] = GF2k<84>{detail::int128(1531173033897685639u, 501862u)};
-        lift_v<4, 88>[0] = GF2k<88>{detail::int128(1u, 0u)};
-        lift_v<4, 88>[1] = GF2k<88>{detail::int128(15992295962588494802u, 12338289u)};
-        lift_v<4, 88>[2] = GF2k<88>{detail::int128(5386578833652860030u, 16517464u)};
-        lift_v<4, 88>[3] = GF2k<88>{detail::int128(5257007919467868989u, 14944296u)};
-        lift_v<4, 92>[0] = GF2k<92>{detail::int128(1u, 0u)};
-        lift_v<4, 92>[1] = GF2k<92>{detail::int128(6359655967573487876u, 103416849u)};
-        lift_v<4, 92>[2] = GF2k<92>{detail::int128(1324836882252726488u, 151089154u)};
-        lift_v<4, 92>[3] = GF2k<92>{detail::int128(16757333349588237294u, 64462831u)};
-        lift_v<4, 96>[0] = GF2k<96>{detail::int128(1u, 0u)};
-        lift_v<4, 96>[1] = GF2k<96>{detail::int128(9304547647518695538u, 2333216580u)};
-        lift_v<4, 96>[2] = GF2k<96>{detail::int128(12620623068371161813u, 3675457604u)};
-        lift_v<4, 96>[3] = GF2k<96>{detail::int128(2754691819569056209u, 152398392u)};
-        lift_v<4, 100>[0] = GF2k<100>{detail::int128(1u, 0u)};
-        lift_v<4, 100>[1] = GF2k<100>{detail::int128(37155831870914592u, 67108864u)};
-        lift_v<4, 100>[2] = GF2k<100>{detail::int128(1152921504640434177u, 2147483712u)};
-        lift_v<4, 100>[3] = GF2k<100>{detail::int128(1190112520849850400u, 2149648450u)};
-        lift_v<4, 104>[0] = GF2k<104>{detail::int128(1u, 0u)};
-        lift_v<4, 104>[1] = GF2k<104>{detail::int128(9729002307186960920u, 692299413800u)};
-        lift_v<4, 104>[2] = GF2k<104>{detail::int128(8860140104996734490u, 807624180193u)};
-        lift_v<4, 104>[3] = GF2k<104>{detail::int128(11302681075627177022u, 353847945905u)};
-        lift_v<4, 108>[0] = GF2k<108>{detail::int128(1u, 0u)};
-        lift_v<4, 108>[1] = GF2k<108>{detail::int128(2731907620205026364u, 9061137898985u)};
-        lift_v<4, 108>[2] = GF2k<108>{detail::int128(3039610016471368783u, 11449098015678u)};
-        lift_v<4, 108>[3] = GF2k<108>{detail::int128(16640031438530799254u, 6246698216040u)};
-        lift_v<4, 112>[0] = GF2k<112>{detail::int128(1u, 0u)};
-        lift_v<4, 112>[1] = GF2k<112>{detail::int128(10068753687735623126u, 19599213199520u)};
-        lift_v<4, 112>[2] = GF2k<112>{detail::int128(12956878165243797385u, 136829031061969u)};
-        lift_v<4, 112>[3] = GF2k<112>{detail::int128(15601370671514302871u, 137070968857891u)};
-        lift_v<4, 116>[0] = GF2k<116>{detail::int128(1u, 0u)};
-        lift_v<4, 116>[1] = GF2k<116>{detail::int128(17074702105875455028u, 927939534880171u)};
-        lift_v<4, 116>[2] = GF2k<116>{detail::int128(10820306015665847195u, 1392298469509700u)};
-        lift_v<4, 116>[3] = GF2k<116>{detail::int128(11431446497207657133u, 4229044592377822u)};
-        lift_v<4, 120>[0] = GF2k<120>{detail::int128(1u, 0u)};
-        lift_v<4, 120>[1] = GF2k<120>{detail::int128(12150032154836860766u, 18934928135246414u)};
-        lift_v<4, 120>[2] = GF2k<120>{detail::int128(1925741831855934435u, 67615433555415189u)};
-        lift_v<4, 120>[3] = GF2k<120>{detail::int128(9451512314469860471u, 68220335877605238u)};
-        lift_v<4, 124>[0] = GF2k<124>{detail::int128(1u, 0u)};
-        lift_v<4, 124>[1] = GF2k<124>{detail::int128(1418406275363461960u, 110620049134471600u)};
-        lift_v<4, 124>[2] = GF2k<124>{detail::int128(15512778258432215618u, 112942167894518246u)};
-        lift_v<4, 124>[3] = GF2k<124>{detail::int128(3655272535387596246u, 559061959618175928u)};
-        lift_v<4, 128>[0] = GF2k<128>{detail::int128(1u, 0u)};
-        lift_v<4, 128>[1] = GF2k<128>{detail::int128(10987152913382278186u, 10036699012426583600u)};
-        lift_v<4, 128>[2] = GF2k<128>{detail::int128(18379359142562139939u, 11678753174964950217u)};
-        lift_v<4, 128>[3] = GF2k<128>{detail::int128(3806377295275615041u, 5765478048843264955u)};
-        lift_v<5, 65>[0] = GF2k<65>{detail::int128(1u, 0u)};
-        lift_v<5, 65>[1] = GF2k<65>{detail::int128(3861875802448541440u, 0u)};
-        lift_v<5, 65>[2] = GF2k<65>{detail::int128(15009910416961938841u, 0u)};
-        lift_v<5, 65>[3] = GF2k<65>{detail::int128(5793776032126485430u, 0u)};
-        lift_v<5, 65>[4] = GF2k<65>{detail::int128(5270255747892624107u, 1u)};
-        lift_v<5, 70>[0] = GF2k<70>{detail::int128(1u, 0u)};
-        lift_v<5, 70>[1] = GF2k<70>{detail::int128(4174489270285340511u, 0u)};
-        lift_v<5, 70>[2] = GF2k<70>{detail::int128(5148616106781912082u, 21u)};
-        lift_v<5, 70>[3] = GF2k<70>{detail::int128(18018453494530323874u, 34u)};
-        lift_v<5, 70>[4] = GF2k<70>{detail::int128(7478673356199550462u, 34u)};
-        lift_v<5, 75>[0] = GF2k<75>{detail::int128(1u, 0u)};
-        lift_v<5, 75>[1] = GF2k<75>{detail::int128(3238600887474666335u, 930u)};
-        lift_v<5, 75>[2] = GF2k<75>{detail::int128(11664967228157220132u, 2012u)};
-        lift_v<5, 75>[3] = GF2k<75>{detail::int128(7355207039322391790u, 428u)};
-        lift_v<5, 75>[4] = GF2k<75>{detail::int128(17882069603744830207u, 1056u)};
-        lift_v<5, 80>[0] = GF2k<80>{detail::int128(1u, 0u)};
-        lift_v<5, 80>[1] = GF2k<80>{detail::int128(10989864255418190985u, 3882u)};
-        lift_v<5, 80>[2] = GF2k<80>{detail::int128(14524818881366158928u, 48985u)};
-        lift_v<5, 80>[3] = GF2k<80>{detail::int128(13994618148360370151u, 4643u)};
-        lift_v<5, 80>[4] = GF2k<80>{detail::int128(14102409561554314758u, 65139u)};
-        lift_v<5, 85>[0] = GF2k<85>{detail::int128(1u, 0u)};
-        lift_v<5, 85>[1] = GF2k<85>{detail::int128(5327656873083886430u, 462420u)};
-        lift_v<5, 85>[2] = GF2k<85>{detail::int128(13792855043168428719u, 925609u)};
-        lift_v<5, 85>[3] = GF2k<85>{detail::int128(4581929423717793632u, 1806380u)};
-        lift_v<5, 85>[4] = GF2k<85>{detail::int128(3814650563124705542u, 863118u)};
-        lift_v<5, 90>[0] = GF2k<90>{detail::int128(1u, 0u)};
-        lift_v<5, 90>[1] = GF2k<90>{detail::int128(35253225783808u, 256u)};
-        lift_v<5, 90>[2] = GF2k<90>{detail::int128(134479873u, 131328u)};
-        lift_v<5, 90>[3] = GF2k<90>{detail::int128(18014467363176961u, 0u)};
-        lift_v<5, 90>[4] = GF2k<90>{detail::int128(513u, 131328u)};
-        lift_v<5, 95>[0] = GF2k<95>{detail::int128(1u, 0u)};
-        lift_v<5, 95>[1] = GF2k<95>{detail::int128(3258617735656930394u, 679801576u)};
-        lift_v<5, 95>[2] = GF2k<95>{detail::int128(13712591774644591436u, 1490338928u)};
-        lift_v<5, 95>[3] = GF2k<95>{detail::int128(531618890714779823u, 864711216u)};
-        lift_v<5, 95>[4] = GF2k<95>{detail::int128(11610678214136525528u, 1943070240u)};
-        lift_v<5, 100>[0] = GF2k<100>{detail::int128(1u, 0u)};
-        lift_v<5, 100>[1] = GF2k<100>{detail::int128(37155831870948384u, 67586u)};
-        lift_v<5, 100>[2] = GF2k<100>{detail::int128(1161084313567233u, 67650u)};
-        lift_v<5, 100>[3] = GF2k<100>{detail::int128(34359772160u, 2214594624u)};
-        lift_v<5, 100>[4] = GF2k<100>{detail::int128(1188985485997932544u, 67110914u)};
-        lift_v<5, 105>[0] = GF2k<105>{detail::int128(1u, 0u)};
-        lift_v<5, 105>[1] = GF2k<105>{detail::int128(12822468179386018324u, 387221185243u)};
-        lift_v<5, 105>[2] = GF2k<105>{detail::int128(11505044429556583194u, 1678299656565u)};
-        lift_v<5, 105>[3] = GF2k<105>{detail::int128(12613549171812427909u, 34782629473u)};
-        lift_v<5, 105>[4] = GF2k<105>{detail::int128(6409423222142337427u, 982149265319u)};
-        lift_v<5, 110>[0] = GF2k<110>{detail::int128(1u, 0u)};
-        lift_v<5, 110>[1] = GF2k<110>{detail::int128(36046397794945024u, 16777216u)};
-        lift_v<5, 110>[2] = GF2k<110>{detail::int128(8594128897u, 34376515584u)};
-        lift_v<5, 110>[3] = GF2k<110>{detail::int128(17600775981057u, 4u)};
-        lift_v<5, 110>[4] = GF2k<110>{detail::int128(2049u, 34376515584u)};
-        lift_v<5, 115>[0] = GF2k<115>{detail::int128(1u, 0u)};
-        lift_v<5, 115>[1] = GF2k<115>{detail::int128(8269284710474808575u, 13422886290784u)};
-        lift_v<5, 115>[2] = GF2k<115>{detail::int128(13669444325322519541u, 1229593096824530u)};
-        lift_v<5, 115>[3] = GF2k<115>{detail::int128(10647133076885529659u, 194186026557923u)};
-        lift_v<5, 115>[4] = GF2k<115>{detail::int128(12547488267973977747u, 67880041392970u)};
-        lift_v<5, 120>[0] = GF2k<120>{detail::int128(1u, 0u)};
-        lift_v<5, 120>[1] = GF2k<120>{detail::int128(13321093522614297287u, 3701442477711404u)};
-        lift_v<5, 120>[2] = GF2k<120>{detail::int128(8089495758416324258u, 20048743555550773u)};
-        lift_v<5, 120>[3] = GF2k<120>{detail::int128(12787051195899315838u, 45092166096497963u)};
-        lift_v<5, 120>[4] = GF2k<120>{detail::int128(8969897094817181400u, 50057967989464108u)};
-        lift_v<5, 125>[0] = GF2k<125>{detail::int128(1u, 0u)};
-        lift_v<5, 125>[1] = GF2k<125>{detail::int128(6212245045445615188u, 151766576495094740u)};
-        lift_v<5, 125>[2] = GF2k<125>{detail::int128(4370714818475846032u, 951055712179159873u)};
-        lift_v<5, 125>[3] = GF2k<125>{detail::int128(13812910981445475322u, 109242400572032731u)};
-        lift_v<5, 125>[4] = GF2k<125>{detail::int128(12889452402882232933u, 1207933922530128780u)};
-        lift_v<7, 70>[0] = GF2k<70>{detail::int128(1u, 0u)};
-        lift_v<7, 70>[1] = GF2k<70>{detail::int128(13153965003349322729u, 5u)};
-        lift_v<7, 70>[2] = GF2k<70>{detail::int128(6053993992151838902u, 14u)};
-        lift_v<7, 70>[3] = GF2k<70>{detail::int128(5040877379099359625u, 60u)};
-        lift_v<7, 70>[4] = GF2k<70>{detail::int128(3112691441290531272u, 50u)};
-        lift_v<7, 70>[5] = GF2k<70>{detail::int128(10979453114966276694u, 40u)};
-        lift_v<7, 70>[6] = GF2k<70>{detail::int128(11154026248222037977u, 45u)};
-        lift_v<7, 77>[0] = GF2k<77>{detail::int128(1u, 0u)};
-        lift_v<7, 77>[1] = GF2k<77>{detail::int128(3735417624577316460u, 1346u)};
-        lift_v<7, 77>[2] = GF2k<77>{detail::int128(15992215445353482463u, 4571u)};
-        lift_v<7, 77>[3] = GF2k<77>{detail::int128(10778517776824015962u, 6641u)};
-        lift_v<7, 77>[4] = GF2k<77>{detail::int128(3199247925833161664u, 3782u)};
-        lift_v<7, 77>[5] = GF2k<77>{detail::int128(10188842209674836481u, 3945u)};
-        lift_v<7, 77>[6] = GF2k<77>{detail::int128(5382162680308557133u, 4490u)};
-        lift_v<7, 84>[0] = GF2k<84>{detail::int128(1u, 0u)};
-        lift_v<7, 84>[1] = GF2k<84>{detail::int128(6912022530607883788u, 201056u)};
-        lift_v<7, 84>[2] = GF2k<84>{detail::int128(7584123065868560821u, 983878u)};
-        lift_v<7, 84>[3] = GF2k<84>{detail::int128(14734140302096463412u, 91442u)};
-        lift_v<7, 84>[4] = GF2k<84>{detail::int128(2623413609232944682u, 660830u)};
-        lift_v<7, 84>[5] = GF2k<84>{detail::int128(1307981348397360614u, 1001185u)};
-        lift_v<7, 84>[6] = GF2k<84>{detail::int128(2241069561577754101u, 424231u)};
-        lift_v<7, 91>[0] = GF2k<91>{detail::int128(1u, 0u)};
-        lift_v<7, 91>[1] = GF2k<91>{detail::int128(16162642319607145275u, 2783553u)};
-        lift_v<7, 91>[2] = GF2k<91>{detail::int128(14583636007863222053u, 97078062u)};
-        lift_v<7, 91>[3] = GF2k<91>{detail::int128(5613832202077667165u, 35510151u)};
-        lift_v<7, 91>[4] = GF2k<91>{detail::int128(17108705044594849728u, 74611323u)};
-        lift_v<7, 91>[5] = GF2k<91>{detail::int128(14538361413299259645u, 84889561u)};
-        lift_v<7, 91>[6] = GF2k<91>{detail::int128(14968809562393779041u, 12277000u)};
-        lift_v<7, 98>[0] = GF2k<98>{detail::int128(1u, 0u)};
-        lift_v<7, 98>[1] = GF2k<98>{detail::int128(10944503327630039763u, 2656338160u)};
-        lift_v<7, 98>[2] = GF2k<98>{detail::int128(1584704678227610660u, 12820051072u)};
-        lift_v<7, 98>[3] = GF2k<98>{detail::int128(1367843937525478741u, 5795636403u)};
-        lift_v<7, 98>[4] = GF2k<98>{detail::int128(2342245924235881327u, 15927626031u)};
-        lift_v<7, 98>[5] = GF2k<98>{detail::int128(10498978204746344061u, 12859123067u)};
-        lift_v<7, 98>[6] = GF2k<98>{detail::int128(3575311934850780360u, 15136070761u)};
-        lift_v<7, 105>[0] = GF2k<105>{detail::int128(1u, 0u)};
-        lift_v<7, 105>[1] = GF2k<105>{detail::int128(7645205933002324880u, 12028527877u)};
-        lift_v<7, 105>[2] = GF2k<105>{detail::int128(1152236327759856384u, 1379320904390u)};
-        lift_v<7, 105>[3] = GF2k<105>{detail::int128(10562620874800096285u, 502308850744u)};
-        lift_v<7, 105>[4] = GF2k<105>{detail::int128(15643698580936949838u, 1482999124761u)};
-        lift_v<7, 105>[5] = GF2k<105>{detail::int128(11723798305650087079u, 1566083180715u)};
-        lift_v<7, 105>[6] = GF2k<105>{detail::int128(15541897274232185201u, 1869914565954u)};
-        lift_v<7, 112>[0] = GF2k<112>{detail::int128(1u, 0u)};
-        lift_v<7, 112>[1] = GF2k<112>{detail::int128(18095823635111680943u, 19970295442714u)};
-        lift_v<7, 112>[2] = GF2k<112>{detail::int128(12729420963249932232u, 68057957587111u)};
-        lift_v<7, 112>[3] = GF2k<112>{detail::int128(9346960114441080112u, 17950588321588u)};
-        lift_v<7, 112>[4] = GF2k<112>{detail::int128(8213918239899962688u, 163764468209655u)};
-        lift_v<7, 112>[5] = GF2k<112>{detail::int128(13757316075957669450u, 67636400530175u)};
-        lift_v<7, 112>[6] = GF2k<112>{detail::int128(656276555396236601u, 136436763986146u)};
-        lift_v<7, 119>[0] = GF2k<119>{detail::int128(1u, 0u)};
-        lift_v<7, 119>[1] = GF2k<119>{detail::int128(17011723667304565749u, 7793146174046204u)};
-        lift_v<7, 119>[2] = GF2k<119>{detail::int128(10048923047010719932u, 24773317020369133u)};
-        lift_v<7, 119>[3] = GF2k<119>{detail::int128(10142088656988542729u, 18451700336080254u)};
-        lift_v<7, 119>[4] = GF2k<119>{detail::int128(2965814374289777301u, 29155862929225907u)};
-        lift_v<7, 119>[5] = GF2k<119>{detail::int128(11691716521925891292u, 22570763908854478u)};
-        lift_v<7, 119>[6] = GF2k<119>{detail::int128(2341902231941900417u, 32307463346583060u)};
-        lift_v<7, 126>[0] = GF2k<126>{detail::int128(1u, 0u)};
-        lift_v<7, 126>[1] = GF2k<126>{detail::int128(8724156424u, 17596481013764u)};
-        lift_v<7, 126>[2] = GF2k<126>{detail::int128(18049583015788544u, 140737563852800u)};
-        lift_v<7, 126>[3] = GF2k<126>{detail::int128(162446874073403912u, 658792492237324580u)};
-        lift_v<7, 126>[4] = GF2k<126>{detail::int128(281474976710656u, 9024795802863648u)};
-        lift_v<7, 126>[5] = GF2k<126>{detail::int128(282093452263424u, 658669316929095968u)};
-        lift_v<7, 126>[6] = GF2k<126>{detail::int128(1153203538063561224u, 657525855437717540u)};
-    }
+    template <> GF2k<66> lift_v<3, 66>[3] = {GF2k<66>{detail::int128(1u, 0u)},GF2k<66>{detail::int128(13590393859353636u, 0u)},GF2k<66>{detail::int128(293888463537711412u, 0u)}};
+    template <> GF2k<69> lift_v<3, 69>[3] = {GF2k<69>{detail::int128(1u, 0u)},GF2k<69>{detail::int128(3830885121293690020u, 6u)},GF2k<69>{detail::int128(8065282976391997751u, 30u)}};
+    template <> GF2k<72> lift_v<3, 72>[3] = {GF2k<72>{detail::int128(1u, 0u)},GF2k<72>{detail::int128(6336268284552524189u, 3u)},GF2k<72>{detail::int128(5454517800467176933u, 75u)}};
+    template <> GF2k<75> lift_v<3, 75>[3] = {GF2k<75>{detail::int128(1u, 0u)},GF2k<75>{detail::int128(15871649223786271521u, 377u)},GF2k<75>{detail::int128(17505696889651349636u, 1496u)}};
+    template <> GF2k<78> lift_v<3, 78>[3] = {GF2k<78>{detail::int128(1u, 0u)},GF2k<78>{detail::int128(6502690503150295118u, 3031u)},GF2k<78>{detail::int128(16753331821363012292u, 11795u)}};
+    template <> GF2k<81> lift_v<3, 81>[3] = {GF2k<81>{detail::int128(1u, 0u)},GF2k<81>{detail::int128(11258874081089016404u, 3950u)},GF2k<81>{detail::int128(3016336880968184730u, 4999u)}};
+    template <> GF2k<84> lift_v<3, 84>[3] = {GF2k<84>{detail::int128(1u, 0u)},GF2k<84>{detail::int128(10508740730572443884u, 211021u)},GF2k<84>{detail::int128(3594861065436500213u, 678596u)}};
+    template <> GF2k<87> lift_v<3, 87>[3] = {GF2k<87>{detail::int128(1u, 0u)},GF2k<87>{detail::int128(2120294475864440404u, 469302u)},GF2k<87>{detail::int128(9753526937005453754u, 1145692u)}};
+    template <> GF2k<90> lift_v<3, 90>[3] = {GF2k<90>{detail::int128(1u, 0u)},GF2k<90>{detail::int128(1297037243531132992u, 18464u)},GF2k<90>{detail::int128(146371385952833544u, 8407044u)}};
+    template <> GF2k<93> lift_v<3, 93>[3] = {GF2k<93>{detail::int128(1u, 0u)},GF2k<93>{detail::int128(6471350698447630505u, 147988550u)},GF2k<93>{detail::int128(12993965911175122027u, 458075376u)}};
+    template <> GF2k<96> lift_v<3, 96>[3] = {GF2k<96>{detail::int128(1u, 0u)},GF2k<96>{detail::int128(12380203306852414734u, 2050575828u)},GF2k<96>{detail::int128(11809411057215125947u, 3445342820u)}};
+    template <> GF2k<99> lift_v<3, 99>[3] = {GF2k<99>{detail::int128(1u, 0u)},GF2k<99>{detail::int128(16553231565667262187u, 8400290770u)},GF2k<99>{detail::int128(4863381025399063222u, 16481804496u)}};
+    template <> GF2k<102> lift_v<3, 102>[3] = {GF2k<102>{detail::int128(1u, 0u)},GF2k<102>{detail::int128(13734529408254840878u, 14640199126u)},GF2k<102>{detail::int128(14661378571639946705u, 158640295145u)}};
+    template <> GF2k<105> lift_v<3, 105>[3] = {GF2k<105>{detail::int128(1u, 0u)},GF2k<105>{detail::int128(12932104876947754886u, 64389323199u)},GF2k<105>{detail::int128(12887872257600252478u, 1385286366046u)}};
+    template <> GF2k<108> lift_v<3, 108>[3] = {GF2k<108>{detail::int128(1u, 0u)},GF2k<108>{detail::int128(17919953340050387491u, 2284999676742u)},GF2k<108>{detail::int128(2369740915872716803u, 7971561826384u)}};
+    template <> GF2k<111> lift_v<3, 111>[3] = {GF2k<111>{detail::int128(1u, 0u)},GF2k<111>{detail::int128(4026013208167156648u, 9733666548147u)},GF2k<111>{detail::int128(5319828388765496942u, 91669938261748u)}};
+    template <> GF2k<114> lift_v<3, 114>[3] = {GF2k<114>{detail::int128(1u, 0u)},GF2k<114>{detail::int128(4974558966096222435u, 74563717814626u)},GF2k<114>{detail::int128(6816542800707707057u, 479821584398017u)}};
+    template <> GF2k<117> lift_v<3, 117>[3] = {GF2k<117>{detail::int128(1u, 0u)},GF2k<117>{detail::int128(3366835236737827659u, 3245756357676900u)},GF2k<117>{detail::int128(12594281500514882725u, 8958095230518815u)}};
+    template <> GF2k<120> lift_v<3, 120>[3] = {GF2k<120>{detail::int128(1u, 0u)},GF2k<120>{detail::int128(1646115861088479006u, 22019381725979525u)},GF2k<120>{detail::int128(653699091415738964u, 45965296981323646u)}};
+    template <> GF2k<123> lift_v<3, 123>[3] = {GF2k<123>{detail::int128(1u, 0u)},GF2k<123>{detail::int128(7360865503288285761u, 254944352558692798u)},GF2k<123>{detail::int128(8594649823352590475u, 440275925003152602u)}};
+    template <> GF2k<126> lift_v<3, 126>[3] = {GF2k<126>{detail::int128(1u, 0u)},GF2k<126>{detail::int128(9223376434903384064u, 0u)},GF2k<126>{detail::int128(4398048608257u, 1048576u)}};
+    template <> GF2k<68> lift_v<4, 68>[4] = {GF2k<68>{detail::int128(1u, 0u)},GF2k<68>{detail::int128(12710093752160264630u, 11u)},GF2k<68>{detail::int128(17386029479123132123u, 13u)},GF2k<68>{detail::int128(15588548817824486596u, 3u)}};
+    template <> GF2k<72> lift_v<4, 72>[4] = {GF2k<72>{detail::int128(1u, 0u)},GF2k<72>{detail::int128(17391388760111519088u, 34u)},GF2k<72>{detail::int128(15612407915177394732u, 104u)},GF2k<72>{detail::int128(4181693157959829933u, 7u)}};
+    template <> GF2k<76> lift_v<4, 76>[4] = {GF2k<76>{detail::int128(1u, 0u)},GF2k<76>{detail::int128(11683891173972340330u, 20u)},GF2k<76>{detail::int128(957076224813831542u, 476u)},GF2k<76>{detail::int128(2873619389214706038u, 128u)}};
+    template <> GF2k<80> lift_v<4, 80>[4] = {GF2k<80>{detail::int128(1u, 0u)},GF2k<80>{detail::int128(14738282592355353704u, 19838u)},GF2k<80>{detail::int128(12461724952694633392u, 41594u)},GF2k<80>{detail::int128(10386040542880409177u, 10790u)}};
+    template <> GF2k<84> lift_v<4, 84>[4] = {GF2k<84>{detail::int128(1u, 0u)},GF2k<84>{detail::int128(11253100945281353594u, 150881u)},GF2k<84>{detail::int128(4342481523985565120u, 861351u)},GF2k<84>{detail::int128(1531173033897685639u, 501862u)}};
+    template <> GF2k<88> lift_v<4, 88>[4] = {GF2k<88>{detail::int128(1u, 0u)},GF2k<88>{detail::int128(15992295962588494802u, 12338289u)},GF2k<88>{detail::int128(5386578833652860030u, 16517464u)},GF2k<88>{detail::int128(5257007919467868989u, 14944296u)}};
+    template <> GF2k<92> lift_v<4, 92>[4] = {GF2k<92>{detail::int128(1u, 0u)},GF2k<92>{detail::int128(6359655967573487876u, 103416849u)},GF2k<92>{detail::int128(1324836882252726488u, 151089154u)},GF2k<92>{detail::int128(16757333349588237294u, 64462831u)}};
+    template <> GF2k<96> lift_v<4, 96>[4] = {GF2k<96>{detail::int128(1u, 0u)},GF2k<96>{detail::int128(9304547647518695538u, 2333216580u)},GF2k<96>{detail::int128(12620623068371161813u, 3675457604u)},GF2k<96>{detail::int128(2754691819569056209u, 152398392u)}};
+    template <> GF2k<100> lift_v<4, 100>[4] = {GF2k<100>{detail::int128(1u, 0u)},GF2k<100>{detail::int128(37155831870914592u, 67108864u)},GF2k<100>{detail::int128(1152921504640434177u, 2147483712u)},GF2k<100>{detail::int128(1190112520849850400u, 2149648450u)}};
+    template <> GF2k<104> lift_v<4, 104>[4] = {GF2k<104>{detail::int128(1u, 0u)},GF2k<104>{detail::int128(9729002307186960920u, 692299413800u)},GF2k<104>{detail::int128(8860140104996734490u, 807624180193u)},GF2k<104>{detail::int128(11302681075627177022u, 353847945905u)}};
+    template <> GF2k<108> lift_v<4, 108>[4] = {GF2k<108>{detail::int128(1u, 0u)},GF2k<108>{detail::int128(2731907620205026364u, 9061137898985u)},GF2k<108>{detail::int128(3039610016471368783u, 11449098015678u)},GF2k<108>{detail::int128(16640031438530799254u, 6246698216040u)}};
+    template <> GF2k<112> lift_v<4, 112>[4] = {GF2k<112>{detail::int128(1u, 0u)},GF2k<112>{detail::int128(10068753687735623126u, 19599213199520u)},GF2k<112>{detail::int128(12956878165243797385u, 136829031061969u)},GF2k<112>{detail::int128(15601370671514302871u, 137070968857891u)}};
+    template <> GF2k<116> lift_v<4, 116>[4] = {GF2k<116>{detail::int128(1u, 0u)},GF2k<116>{detail::int128(17074702105875455028u, 927939534880171u)},GF2k<116>{detail::int128(10820306015665847195u, 1392298469509700u)},GF2k<116>{detail::int128(11431446497207657133u, 4229044592377822u)}};
+    template <> GF2k<120> lift_v<4, 120>[4] = {GF2k<120>{detail::int128(1u, 0u)},GF2k<120>{detail::int128(12150032154836860766u, 18934928135246414u)},GF2k<120>{detail::int128(1925741831855934435u, 67615433555415189u)},GF2k<120>{detail::int128(9451512314469860471u, 68220335877605238u)}};
+    template <> GF2k<124> lift_v<4, 124>[4] = {GF2k<124>{detail::int128(1u, 0u)},GF2k<124>{detail::int128(1418406275363461960u, 110620049134471600u)},GF2k<124>{detail::int128(15512778258432215618u, 112942167894518246u)},GF2k<124>{detail::int128(3655272535387596246u, 559061959618175928u)}};
+    template <> GF2k<128> lift_v<4, 128>[4] = {GF2k<128>{detail::int128(1u, 0u)},GF2k<128>{detail::int128(10987152913382278186u, 10036699012426583600u)},GF2k<128>{detail::int128(18379359142562139939u, 11678753174964950217u)},GF2k<128>{detail::int128(3806377295275615041u, 5765478048843264955u)}};
+    template <> GF2k<65> lift_v<5, 65>[5] = {GF2k<65>{detail::int128(1u, 0u)},GF2k<65>{detail::int128(3861875802448541440u, 0u)},GF2k<65>{detail::int128(15009910416961938841u, 0u)},GF2k<65>{detail::int128(5793776032126485430u, 0u)},GF2k<65>{detail::int128(5270255747892624107u, 1u)}};
+    template <> GF2k<70> lift_v<5, 70>[5] = {GF2k<70>{detail::int128(1u, 0u)},GF2k<70>{detail::int128(4174489270285340511u, 0u)},GF2k<70>{detail::int128(5148616106781912082u, 21u)},GF2k<70>{detail::int128(18018453494530323874u, 34u)},GF2k<70>{detail::int128(7478673356199550462u, 34u)}};
+    template <> GF2k<75> lift_v<5, 75>[5] = {GF2k<75>{detail::int128(1u, 0u)},GF2k<75>{detail::int128(3238600887474666335u, 930u)},GF2k<75>{detail::int128(11664967228157220132u, 2012u)},GF2k<75>{detail::int128(7355207039322391790u, 428u)},GF2k<75>{detail::int128(17882069603744830207u, 1056u)}};
+    template <> GF2k<80> lift_v<5, 80>[5] = {GF2k<80>{detail::int128(1u, 0u)},GF2k<80>{detail::int128(10989864255418190985u, 3882u)},GF2k<80>{detail::int128(14524818881366158928u, 48985u)},GF2k<80>{detail::int128(13994618148360370151u, 4643u)},GF2k<80>{detail::int128(14102409561554314758u, 65139u)}};
+    template <> GF2k<85> lift_v<5, 85>[5] = {GF2k<85>{detail::int128(1u, 0u)},GF2k<85>{detail::int128(5327656873083886430u, 462420u)},GF2k<85>{detail::int128(13792855043168428719u, 925609u)},GF2k<85>{detail::int128(4581929423717793632u, 1806380u)},GF2k<85>{detail::int128(3814650563124705542u, 863118u)}};
+    template <> GF2k<90> lift_v<5, 90>[5] = {GF2k<90>{detail::int128(1u, 0u)},GF2k<90>{detail::int128(35253225783808u, 256u)},GF2k<90>{detail::int128(134479873u, 131328u)},GF2k<90>{detail::int128(18014467363176961u, 0u)},GF2k<90>{detail::int128(513u, 131328u)}};
+    template <> GF2k<95> lift_v<5, 95>[5] = {GF2k<95>{detail::int128(1u, 0u)},GF2k<95>{detail::int128(3258617735656930394u, 679801576u)},GF2k<95>{detail::int128(13712591774644591436u, 1490338928u)},GF2k<95>{detail::int128(531618890714779823u, 864711216u)},GF2k<95>{detail::int128(11610678214136525528u, 1943070240u)}};
+    template <> GF2k<100> lift_v<5, 100>[5] = {GF2k<100>{detail::int128(1u, 0u)},GF2k<100>{detail::int128(37155831870948384u, 67586u)},GF2k<100>{detail::int128(1161084313567233u, 67650u)},GF2k<100>{detail::int128(34359772160u, 2214594624u)},GF2k<100>{detail::int128(1188985485997932544u, 67110914u)}};
+    template <> GF2k<105> lift_v<5, 105>[5] = {GF2k<105>{detail::int128(1u, 0u)},GF2k<105>{detail::int128(12822468179386018324u, 387221185243u)},GF2k<105>{detail::int128(11505044429556583194u, 1678299656565u)},GF2k<105>{detail::int128(12613549171812427909u, 34782629473u)},GF2k<105>{detail::int128(6409423222142337427u, 982149265319u)}};
+    template <> GF2k<110> lift_v<5, 110>[5] = {GF2k<110>{detail::int128(1u, 0u)},GF2k<110>{detail::int128(36046397794945024u, 16777216u)},GF2k<110>{detail::int128(8594128897u, 34376515584u)},GF2k<110>{detail::int128(17600775981057u, 4u)},GF2k<110>{detail::int128(2049u, 34376515584u)}};
+    template <> GF2k<115> lift_v<5, 115>[5] = {GF2k<115>{detail::int128(1u, 0u)},GF2k<115>{detail::int128(8269284710474808575u, 13422886290784u)},GF2k<115>{detail::int128(13669444325322519541u, 1229593096824530u)},GF2k<115>{detail::int128(10647133076885529659u, 194186026557923u)},GF2k<115>{detail::int128(12547488267973977747u, 67880041392970u)}};
+    template <> GF2k<120> lift_v<5, 120>[5] = {GF2k<120>{detail::int128(1u, 0u)},GF2k<120>{detail::int128(13321093522614297287u, 3701442477711404u)},GF2k<120>{detail::int128(8089495758416324258u, 20048743555550773u)},GF2k<120>{detail::int128(12787051195899315838u, 45092166096497963u)},GF2k<120>{detail::int128(8969897094817181400u, 50057967989464108u)}};
+    template <> GF2k<125> lift_v<5, 125>[5] = {GF2k<125>{detail::int128(1u, 0u)},GF2k<125>{detail::int128(6212245045445615188u, 151766576495094740u)},GF2k<125>{detail::int128(4370714818475846032u, 951055712179159873u)},GF2k<125>{detail::int128(13812910981445475322u, 109242400572032731u)},GF2k<125>{detail::int128(12889452402882232933u, 1207933922530128780u)}};
+    template <> GF2k<70> lift_v<7, 70>[7] = {GF2k<70>{detail::int128(1u, 0u)},GF2k<70>{detail::int128(13153965003349322729u, 5u)},GF2k<70>{detail::int128(6053993992151838902u, 14u)},GF2k<70>{detail::int128(5040877379099359625u, 60u)},GF2k<70>{detail::int128(3112691441290531272u, 50u)},GF2k<70>{detail::int128(10979453114966276694u, 40u)},GF2k<70>{detail::int128(11154026248222037977u, 45u)}};
+    template <> GF2k<77> lift_v<7, 77>[7] = {GF2k<77>{detail::int128(1u, 0u)},GF2k<77>{detail::int128(3735417624577316460u, 1346u)},GF2k<77>{detail::int128(15992215445353482463u, 4571u)},GF2k<77>{detail::int128(10778517776824015962u, 6641u)},GF2k<77>{detail::int128(3199247925833161664u, 3782u)},GF2k<77>{detail::int128(10188842209674836481u, 3945u)},GF2k<77>{detail::int128(5382162680308557133u, 4490u)}};
+    template <> GF2k<84> lift_v<7, 84>[7] = {GF2k<84>{detail::int128(1u, 0u)},GF2k<84>{detail::int128(6912022530607883788u, 201056u)},GF2k<84>{detail::int128(7584123065868560821u, 983878u)},GF2k<84>{detail::int128(14734140302096463412u, 91442u)},GF2k<84>{detail::int128(2623413609232944682u, 660830u)},GF2k<84>{detail::int128(1307981348397360614u, 1001185u)},GF2k<84>{detail::int128(2241069561577754101u, 424231u)}};
+    template <> GF2k<91> lift_v<7, 91>[7] = {GF2k<91>{detail::int128(1u, 0u)},GF2k<91>{detail::int128(16162642319607145275u, 2783553u)},GF2k<91>{detail::int128(14583636007863222053u, 97078062u)},GF2k<91>{detail::int128(5613832202077667165u, 35510151u)},GF2k<91>{detail::int128(17108705044594849728u, 74611323u)},GF2k<91>{detail::int128(14538361413299259645u, 84889561u)},GF2k<91>{detail::int128(14968809562393779041u, 12277000u)}};
+    template <> GF2k<98> lift_v<7, 98>[7] = {GF2k<98>{detail::int128(1u, 0u)},GF2k<98>{detail::int128(10944503327630039763u, 2656338160u)},GF2k<98>{detail::int128(1584704678227610660u, 12820051072u)},GF2k<98>{detail::int128(1367843937525478741u, 5795636403u)},GF2k<98>{detail::int128(2342245924235881327u, 15927626031u)},GF2k<98>{detail::int128(10498978204746344061u, 12859123067u)},GF2k<98>{detail::int128(3575311934850780360u, 15136070761u)}};
+    template <> GF2k<105> lift_v<7, 105>[7] = {GF2k<105>{detail::int128(1u, 0u)},GF2k<105>{detail::int128(7645205933002324880u, 12028527877u)},GF2k<105>{detail::int128(1152236327759856384u, 1379320904390u)},GF2k<105>{detail::int128(10562620874800096285u, 502308850744u)},GF2k<105>{detail::int128(15643698580936949838u, 1482999124761u)},GF2k<105>{detail::int128(11723798305650087079u, 1566083180715u)},GF2k<105>{detail::int128(15541897274232185201u, 1869914565954u)}};
+    template <> GF2k<112> lift_v<7, 112>[7] = {GF2k<112>{detail::int128(1u, 0u)},GF2k<112>{detail::int128(18095823635111680943u, 19970295442714u)},GF2k<112>{detail::int128(12729420963249932232u, 68057957587111u)},GF2k<112>{detail::int128(9346960114441080112u, 17950588321588u)},GF2k<112>{detail::int128(8213918239899962688u, 163764468209655u)},GF2k<112>{detail::int128(13757316075957669450u, 67636400530175u)},GF2k<112>{detail::int128(656276555396236601u, 136436763986146u)}};
+    template <> GF2k<119> lift_v<7, 119>[7] = {GF2k<119>{detail::int128(1u, 0u)},GF2k<119>{detail::int128(17011723667304565749u, 7793146174046204u)},GF2k<119>{detail::int128(10048923047010719932u, 24773317020369133u)},GF2k<119>{detail::int128(10142088656988542729u, 18451700336080254u)},GF2k<119>{detail::int128(2965814374289777301u, 29155862929225907u)},GF2k<119>{detail::int128(11691716521925891292u, 22570763908854478u)},GF2k<119>{detail::int128(2341902231941900417u, 32307463346583060u)}};
+    template <> GF2k<126> lift_v<7, 126>[7] = {GF2k<126>{detail::int128(1u, 0u)},GF2k<126>{detail::int128(8724156424u, 17596481013764u)},GF2k<126>{detail::int128(18049583015788544u, 140737563852800u)},GF2k<126>{detail::int128(162446874073403912u, 658792492237324580u)},GF2k<126>{detail::int128(281474976710656u, 9024795802863648u)},GF2k<126>{detail::int128(282093452263424u, 658669316929095968u)},GF2k<126>{detail::int128(1153203538063561224u, 657525855437717540u)}};
 } // namespace gflifttables
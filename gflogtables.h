@@ -0,0 +1,24 @@
+
+// This file was automatically generated, changes may be overwritten
+#pragma once
+#include <cstdint>
+// Discrete logarithm and exponentiation tables, the exponentiation table is repeated twice
+// so that the sum of two logarithms can be used as an index directly
+namespace gflogtables {
+    extern const std::uint16_t log9[1<<9];
+    extern const std::uint16_t exp9[2 * ((1<<9) - 1)];
+    extern const std::uint16_t log10[1<<10];
+    extern const std::uint16_t exp10[2 * ((1<<10) - 1)];
+    extern const std::uint16_t log11[1<<11];
+    extern const std::uint16_t exp11[2 * ((1<<11) - 1)];
+    extern const std::uint16_t log12[1<<12];
+    extern const std::uint16_t exp12[2 * ((1<<12) - 1)];
+    extern const std::uint16_t log13[1<<13];
+    extern const std::uint16_t exp13[2 * ((1<<13) - 1)];
+    extern const std::uint16_t log14[1<<14];
+    extern const std::uint16_t exp14[2 * ((1<<14) - 1)];
+    extern const std::uint16_t log15[1<<15];
+    extern const std::uint16_t exp15[2 * ((1<<15) - 1)];
+    extern const std::uint16_t log16[1<<16];
+    extern const std::uint16_t exp16[2 * ((1<<16) - 1)];
+} // namespace gflogtables
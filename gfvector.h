@@ -0,0 +1,181 @@
+/*
+Copyright (c) 2022, COSIC-KU Leuven, Kasteelpark Arenberg 10, bus 2452, B-3001 Leuven-Heverlee, Belgium.
+
+All rights reserved
+*/
+#pragma once
+
+#include "arith.h"
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace detail {
+    // Cache line aligned, so that the vectorized kernels never straddle two lines for a single load
+    constexpr std::size_t GFVECTOR_ALIGNMENT = 64;
+
+    template <typename T>
+    class AlignedAllocator {
+        public:
+            using value_type = T;
+
+            AlignedAllocator() = default;
+            template <typename U>
+            AlignedAllocator(const AlignedAllocator<U>&) {}
+
+            T* allocate(std::size_t n) {
+                return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(GFVECTOR_ALIGNMENT)));
+            }
+            void deallocate(T* p, std::size_t /* n */) {
+                ::operator delete(p, std::align_val_t(GFVECTOR_ALIGNMENT));
+            }
+
+            template <typename U>
+            bool operator==(const AlignedAllocator<U>&) const { return true; }
+            template <typename U>
+            bool operator!=(const AlignedAllocator<U>&) const { return false; }
+    };
+} // namespace detail
+
+/**
+ * Read-only view on a contiguous range of field elements
+ */
+template <int k>
+class ConstGFSpan {
+    public:
+        ConstGFSpan(const GF2k<k>* data, std::size_t size) : m_data(data), m_size(size) {}
+        ConstGFSpan(const std::vector<GF2k<k>>& v) : m_data(v.data()), m_size(v.size()) {}
+
+        std::size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        const GF2k<k>* data() const { return m_data; }
+        const GF2k<k>& operator[](std::size_t i) const { return m_data[i]; }
+        const GF2k<k>* begin() const { return m_data; }
+        const GF2k<k>* end() const { return m_data + m_size; }
+
+        ConstGFSpan<k> subspan(std::size_t offset, std::size_t len) const {
+            assert(offset + len <= m_size);
+            return {m_data + offset, len};
+        }
+
+        GF2k<k> dot(ConstGFSpan<k> other) const {
+            assert(m_size == other.m_size);
+            return batch::dot(m_data, other.m_data, m_size);
+        }
+
+    private:
+        const GF2k<k>* m_data;
+        std::size_t m_size;
+};
+
+/**
+ * Mutable view on a contiguous range of field elements, with the bulk arithmetic operations
+ */
+template <int k>
+class GFSpan {
+    public:
+        GFSpan(GF2k<k>* data, std::size_t size) : m_data(data), m_size(size) {}
+        GFSpan(std::vector<GF2k<k>>& v) : m_data(v.data()), m_size(v.size()) {}
+
+        operator ConstGFSpan<k>() const { return {m_data, m_size}; }
+
+        std::size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        GF2k<k>* data() const { return m_data; }
+        GF2k<k>& operator[](std::size_t i) const { return m_data[i]; }
+        GF2k<k>* begin() const { return m_data; }
+        GF2k<k>* end() const { return m_data + m_size; }
+
+        GFSpan<k> subspan(std::size_t offset, std::size_t len) const {
+            assert(offset + len <= m_size);
+            return {m_data + offset, len};
+        }
+
+        // this += a * x
+        void axpy(const GF2k<k>& a, ConstGFSpan<k> x) const {
+            assert(m_size == x.size());
+            batch::axpy(m_data, a, x.data(), m_size);
+        }
+
+        // this *= a
+        void scale(const GF2k<k>& a) const {
+            batch::scale(m_data, a, m_data, m_size);
+        }
+
+        // this[i] *= x[i]
+        void mul(ConstGFSpan<k> x) const {
+            assert(m_size == x.size());
+            batch::mul(m_data, m_data, x.data(), m_size);
+        }
+
+        // this[i] += a[i] * b[i]
+        void mul_acc(ConstGFSpan<k> a, ConstGFSpan<k> b) const {
+            assert(m_size == a.size() && m_size == b.size());
+            batch::mul_acc(m_data, a.data(), b.data(), m_size);
+        }
+
+        GF2k<k> dot(ConstGFSpan<k> other) const {
+            return ConstGFSpan<k>(*this).dot(other);
+        }
+
+    private:
+        GF2k<k>* m_data;
+        std::size_t m_size;
+};
+
+/**
+ * Owning, aligned and contiguous storage for a vector of field elements
+ *
+ * Behaves like a std::vector, and converts to spans for the bulk operations
+ */
+template <int k>
+class GFVector {
+    private:
+        using Storage = std::vector<GF2k<k>, detail::AlignedAllocator<GF2k<k>>>;
+
+    public:
+        GFVector() = default;
+        explicit GFVector(std::size_t n) : m_data(n, GF2k<k>(0)) {}
+        GFVector(std::size_t n, const GF2k<k>& el) : m_data(n, el) {}
+        GFVector(ConstGFSpan<k> span) : m_data(span.begin(), span.end()) {}
+
+        operator GFSpan<k>() { return span(); }
+        operator ConstGFSpan<k>() const { return span(); }
+        GFSpan<k> span() { return {m_data.data(), m_data.size()}; }
+        ConstGFSpan<k> span() const { return {m_data.data(), m_data.size()}; }
+        GFSpan<k> subspan(std::size_t offset, std::size_t len) { return span().subspan(offset, len); }
+        ConstGFSpan<k> subspan(std::size_t offset, std::size_t len) const { return span().subspan(offset, len); }
+
+        std::size_t size() const { return m_data.size(); }
+        bool empty() const { return m_data.empty(); }
+        void reserve(std::size_t n) { m_data.reserve(n); }
+        void resize(std::size_t n) { m_data.resize(n, GF2k<k>(0)); }
+        void clear() { m_data.clear(); }
+
+        void push_back(const GF2k<k>& el) { m_data.push_back(el); }
+        template <typename... Args>
+        GF2k<k>& emplace_back(Args&&... args) { return m_data.emplace_back(std::forward<Args>(args)...); }
+
+        GF2k<k>* data() { return m_data.data(); }
+        const GF2k<k>* data() const { return m_data.data(); }
+        GF2k<k>& operator[](std::size_t i) { return m_data[i]; }
+        const GF2k<k>& operator[](std::size_t i) const { return m_data[i]; }
+        GF2k<k>& back() { return m_data.back(); }
+        const GF2k<k>& back() const { return m_data.back(); }
+        auto begin() { return m_data.begin(); }
+        auto end() { return m_data.end(); }
+        auto begin() const { return m_data.begin(); }
+        auto end() const { return m_data.end(); }
+
+        void axpy(const GF2k<k>& a, ConstGFSpan<k> x) { span().axpy(a, x); }
+        void scale(const GF2k<k>& a) { span().scale(a); }
+        void mul(ConstGFSpan<k> x) { span().mul(x); }
+        void mul_acc(ConstGFSpan<k> a, ConstGFSpan<k> b) { span().mul_acc(a, b); }
+        GF2k<k> dot(ConstGFSpan<k> other) const { return span().dot(other); }
+
+    private:
+        Storage m_data;
+};
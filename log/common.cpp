@@ -5,8 +5,19 @@ All rights reserved
 */
 #include "config.h"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <sstream>
 #include <vector>
 
+#include "gfvector.h"
+#include "thread_pool.h"
+
 /**
  * Randomize the multiplication triples x_i * y_i = z_i by r_i to the inner product triple
  *  <{r_i x_i}_i, {y_i}_i> = \sum_i r_i z_i
@@ -16,16 +27,143 @@ All rights reserved
  *
  * x_i gets changed to r_i x^i, *in place*
  *
+ * The z_i for the AND gates are still in the subfield, and are followed by a single (extension field) z
+ *  for the ZK masking triple, so the sum \sum_i r_i lift(z_i) only takes a few full multiplications
+ *
  * Returns \sum_i r_i z_i
  */
-CheckEl randomize_to_inner_product(std::vector<CheckEl>& xs, const std::vector<CheckEl>& zs, PRNG& gen) {
-    assert(xs.size() == zs.size());
+CheckEl randomize_to_inner_product(GFVector<K_EXT>& xs, ConstGFSpan<K> zs, const CheckEl& last_z, PRNG& gen) {
+    assert(xs.size() == zs.size() + 1);
+    // Draw the r_i a block at a time, so the multiplications can be batched
+    constexpr std::size_t BLOCK = 1024;
+    std::array<CheckEl, BLOCK> rs;
     CheckEl res{0};
-    for (std::size_t i = 0; i < xs.size(); i++) {
-        CheckEl r = CheckEl::random(gen);
-        xs[i] *= r;
-        res += zs[i] * r;
+    for (std::size_t i = 0; i < xs.size(); i += BLOCK) {
+        std::size_t len = std::min(BLOCK, xs.size() - i);
+        for (std::size_t j = 0; j < len; j++) rs[j] = CheckEl::random(gen);
+        xs.subspan(i, len).mul(ConstGFSpan<K_EXT>(rs.data(), len));
+        std::size_t sublen = std::min(len, zs.size() - i);
+        res += batch::lifted_dot(zs.data() + i, rs.data(), sublen);
+        if (sublen < len) res += rs[sublen] * last_z;
     }
     return res;
 }
 
+// Below this many elements per thread, a fold or accumulation is not worth splitting up
+constexpr std::size_t PARALLEL_CHUNK = 1 << 12;
+
+/**
+ * Replace every COMPRESSION consecutive elements of `xs` by their dot product with `weights`, in place
+ *
+ * The results go to the front of the buffer; a final incomplete group is implicitly padded with zeroes.
+ * Shrinking keeps the capacity, so nothing is reallocated.
+ * With several threads, every thread first folds its groups into a buffer of its own,
+ *  since the front of the vector could still be read by another thread.
+ */
+void fold_in_place(GFVector<K_EXT>& xs, ConstGFSpan<K_EXT> weights, ThreadPool& pool) {
+    assert(weights.size() == COMPRESSION);
+    std::size_t n = xs.size(), groups = (n + COMPRESSION - 1) / COMPRESSION;
+    auto fold = [&](std::size_t g) {
+        std::size_t i = g * COMPRESSION;
+        return batch::dot(xs.data() + i, weights.data(), std::min<std::size_t>(COMPRESSION, n - i));
+    };
+
+    if (groups < 2 * PARALLEL_CHUNK || pool.size() == 1) {
+        for (std::size_t g = 0; g < groups; g++) xs[g] = fold(g);
+    } else {
+        std::vector<GFVector<K_EXT>> folded(pool.size());
+        std::vector<std::size_t> offsets(pool.size());
+        pool.parallel_for(groups, [&](std::size_t begin, std::size_t end, unsigned t) {
+            offsets[t] = begin;
+            folded[t].reserve(end - begin);
+            for (std::size_t g = begin; g < end; g++) folded[t].push_back(fold(g));
+        }, PARALLEL_CHUNK);
+        pool.parallel_for(groups, [&](std::size_t, std::size_t, unsigned t) {
+            std::copy(folded[t].begin(), folded[t].end(), xs.begin() + offsets[t]);
+        }, PARALLEL_CHUNK);
+    }
+    xs.resize(groups);
+}
+
+/**
+ * The number of compression rounds until a single triple is left, starting from `n` triples
+ */
+std::size_t compression_rounds(std::size_t n) {
+    std::size_t rounds = 0;
+    for (; n > 1; rounds++) n = (n + COMPRESSION - 1) / COMPRESSION;
+    return rounds;
+}
+
+/**
+ * The number of compression rounds to do while streaming over the AND gates, from the environment variable
+ *  FETA_STREAMING_ROUNDS; zero, the default, keeps every triple in memory
+ *
+ * Every round streamed divides the memory for the folded triples by COMPRESSION,
+ *  at the cost of another pass over the AND gates for the prover.
+ */
+std::size_t streaming_rounds() {
+    const char* value = std::getenv("FETA_STREAMING_ROUNDS");
+    if (value == nullptr) return 0;
+
+    std::istringstream reader(value);
+    int requested = -1;
+    reader >> requested;
+    if (!reader || requested < 0) {
+        std::cerr << "Ignoring invalid number of streaming rounds " << value << std::endl;
+        return 0;
+    }
+    return requested;
+}
+
+/**
+ * Folds a stream of (x, y) pairs through compression rounds whose evaluation points are already known,
+ *  with `weights[l]` the interpolate_preprocess weights of the l-th of them
+ *
+ * Every COMPRESSION pairs on one level become a single pair on the next, and pairs that made it through all levels
+ *  go to `sink`. Only an incomplete group per level is kept, and finish() pads those with zeroes like fold_in_place.
+ */
+class StreamingFold {
+    public:
+        using Sink = std::function<void(const CheckEl&, const CheckEl&)>;
+
+        StreamingFold(std::vector<std::vector<CheckEl>> weights, Sink sink)
+            : m_weights(std::move(weights)), m_xs(m_weights.size()), m_ys(m_weights.size()), m_sink(std::move(sink)) { }
+
+        void push(const CheckEl& x, const CheckEl& y) {
+            push(0, x, y);
+        }
+
+        /**
+         * Fold the incomplete groups, lowest level first, so they can still complete the ones above
+         */
+        void finish() {
+            for (std::size_t level = 0; level < m_weights.size(); level++) {
+                if (!m_xs[level].empty()) fold(level);
+            }
+        }
+
+    private:
+        void push(std::size_t level, const CheckEl& x, const CheckEl& y) {
+            if (level == m_weights.size()) {
+                m_sink(x, y);
+                return;
+            }
+            m_xs[level].push_back(x);
+            m_ys[level].push_back(y);
+            if (m_xs[level].size() == COMPRESSION) fold(level);
+        }
+
+        void fold(std::size_t level) {
+            auto& xs = m_xs[level];
+            auto& ys = m_ys[level];
+            CheckEl x = batch::dot(xs.data(), m_weights[level].data(), xs.size());
+            CheckEl y = batch::dot(ys.data(), m_weights[level].data(), ys.size());
+            xs.clear();
+            ys.clear();
+            push(level + 1, x, y);
+        }
+
+        std::vector<std::vector<CheckEl>> m_weights;
+        std::vector<std::vector<CheckEl>> m_xs, m_ys;
+        Sink m_sink;
+};
@@ -5,107 +5,363 @@ All rights reserved
 */
 #include "config.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <utility>
+#include <vector>
 
+#include "bitvector.h"
 #include "Circuit.h"
 #include "decoder.h"
+#include "gfvector.h"
 #include "io.h"
 #include "player.h"
+#include "thread_pool.h"
 
 #include "common.cpp" // Very ugly, but allows for nice inlining and some shared code between prover and verifier
 
+/**
+ * Commit to `product_poly` by emitting differences between its coefficients and `preprocessing` elements to `output`,
+ *  and return the Fiat-Shamir evaluation point for the compression
+ */
+CheckEl commit_product_poly(
+        const std::array<CheckEl, 2*COMPRESSION-1>& product_poly,
+        GFReader<K_EXT>& preprocessing,
+        GFWriter<K_EXT>& output,
+        const std::shared_ptr<HashableBufferBitWriter>& outwriter) {
+    for (int i = 0; i < 2*COMPRESSION - 2; i++) { // Commit to deg out of deg + 1 coefficients
+        output.next(preprocessing.next() - product_poly[i]);
+    }
+
+    PRNG gen;
+    outwriter->hash_seed(gen);
+    return CheckEl::random(gen);
+}
+
 /**
  * Commit to the sum of product polynomials by emitting differences
  *  between the coefficients and `preprocessing` elements to `output`.
  *
- * Then the inner-product triple is compressed by performing a Schwartz-Zippel evaluation.
+ * Then the inner-product triple is compressed by performing a Schwartz-Zippel evaluation,
+ *  folding `xs` and `ys` in place and returning the new inner product.
  */
-std::tuple<CheckEl, std::vector<CheckEl>, std::vector<CheckEl>> commit_and_compress(
+CheckEl commit_and_compress(
         const CheckEl& innerprod,
-        const std::vector<CheckEl>& xs,
-        const std::vector<CheckEl>& ys,
+        GFVector<K_EXT>& xs,
+        GFVector<K_EXT>& ys,
         GFReader<K_EXT>& preprocessing,
         GFWriter<K_EXT>& output,
-        const std::shared_ptr<HashableBufferBitWriter>& outwriter) {
+        const std::shared_ptr<HashableBufferBitWriter>& outwriter,
+        ThreadPool& pool) {
+
+    std::size_t num_elem = xs.size();
+    std::size_t groups = (num_elem + COMPRESSION - 1) / COMPRESSION;
 
-    int num_elem = xs.size();
+    // Sum of the products of the interpolated polynomials, reduced only once at the end
+    // Every thread sums its own groups, and the partial sums are added afterwards
+    std::vector<std::array<GF2kAccumulator<K_EXT>, 2*COMPRESSION-1>> partial_acc(pool.size());
+    pool.parallel_for(groups, [&](std::size_t begin, std::size_t end, unsigned t) {
+        for (std::size_t g = begin; g < end; g++) {
+            // If it's not evenly divisible; implicitly fill with zeroes
+            std::array<CheckEl, COMPRESSION> x_pts, y_pts;
+            for (std::size_t j = 0; j < COMPRESSION; j++) {
+                std::size_t i = g * COMPRESSION + j;
+                x_pts[j] = i < num_elem ? xs[i] : CheckEl{0};
+                y_pts[j] = i < num_elem ? ys[i] : CheckEl{0};
+            }
+            poly_mul_acc(partial_acc[t], interpolate_poly(x_pts), interpolate_poly(y_pts));
+        }
+    }, PARALLEL_CHUNK);
+    std::array<GF2kAccumulator<K_EXT>, 2*COMPRESSION-1> product_acc;
+    for (const auto& acc : partial_acc) {
+        for (int j = 0; j < 2*COMPRESSION - 1; j++) product_acc[j] += acc[j];
+    }
 
-    std::array<CheckEl, 2*COMPRESSION-1> product_poly{CheckEl{0}};
-    int i;
-    for (i = 0; i <= num_elem - COMPRESSION; i += COMPRESSION) {
-        std::array<CheckEl, COMPRESSION> x_pts, y_pts;
-        for (int j = 0; j < COMPRESSION; j++) x_pts[j] = xs[i + j];
-        for (int j = 0; j < COMPRESSION; j++) y_pts[j] = ys[i + j];
+    std::array<CheckEl, 2*COMPRESSION-1> product_poly;
+    for (int j = 0; j < 2*COMPRESSION - 1; j++) product_poly[j] = product_acc[j].reduce();
+    CheckEl r = commit_product_poly(product_poly, preprocessing, output, outwriter);
 
-        auto to_add = poly_mul(interpolate_poly(x_pts), interpolate_poly(y_pts));
+    // Do the compression
+    auto preproc = interpolate_preprocess(COMPRESSION, r);
+    fold_in_place(xs, preproc, pool);
+    fold_in_place(ys, preproc, pool);
+    CheckEl z = xs.dot(ys);
 
-        for (int j = 0; j < 2*COMPRESSION - 1; j++) {
-            product_poly[j] += to_add[j];
+    assert(z == poly_eval(product_poly, r));
+    return z;
+}
+
+/**
+ * The sum of `poly` over the points 0, ..., COMPRESSION - 1, which is the inner product it was built for
+ */
+CheckEl sum_over_points(const std::array<CheckEl, 2*COMPRESSION-1>& poly) {
+    CheckEl sum{0};
+    for (int t = 0; t < COMPRESSION; t++) sum += poly_eval(poly, CheckEl(t));
+    return sum;
+}
+
+/**
+ * Sums the product polynomials of every COMPRESSION consecutive pairs pushed, padding the last group with zeroes,
+ *  like commit_and_compress does for whole vectors
+ */
+class StreamingProduct {
+    public:
+        void push(const CheckEl& x, const CheckEl& y) {
+            m_xs[m_len] = x;
+            m_ys[m_len] = y;
+            if (++m_len == COMPRESSION) flush();
         }
-    }
 
-    // If it's not evenly divisible; implicitly fill with zeroes
-    if (i < num_elem) {
-        std::array<CheckEl, COMPRESSION> x_pts, y_pts;
-        int j;
-        for (j = 0; i + j < num_elem; j++) {
-            x_pts[j] = xs[i + j];
-            y_pts[j] = ys[i + j];
+        std::array<CheckEl, 2*COMPRESSION-1> finish() {
+            if (m_len > 0) flush();
+            std::array<CheckEl, 2*COMPRESSION-1> res;
+            for (int j = 0; j < 2*COMPRESSION - 1; j++) res[j] = m_acc[j].reduce();
+            return res;
         }
-        for (; j < COMPRESSION; j++) {
-            x_pts[j] = CheckEl{0};
-            y_pts[j] = CheckEl{0};
+
+    private:
+        void flush() {
+            for (std::size_t j = m_len; j < COMPRESSION; j++) m_xs[j] = m_ys[j] = CheckEl{0};
+            poly_mul_acc(m_acc, interpolate_poly(m_xs), interpolate_poly(m_ys));
+            m_len = 0;
         }
 
-        auto to_add = poly_mul(interpolate_poly(x_pts), interpolate_poly(y_pts));
+        std::array<CheckEl, COMPRESSION> m_xs, m_ys;
+        std::size_t m_len = 0;
+        std::array<GF2kAccumulator<K_EXT>, 2*COMPRESSION-1> m_acc;
+};
 
-        for (int j = 0; j < 2*COMPRESSION - 1; j++) {
-            product_poly[j] += to_add[j];
+/**
+ * The AND gates as bits, followed by the dense masking triple, randomized by r_i drawn from `gen`
+ *  into the inner product triple with x_i = r_i a_i and y_i = b_i
+ *
+ * Only the bits are stored: every pass draws the r_i again from a copy of the initial `gen` state,
+ *  a block of groups at a time. The group with the masking triple goes through dense polynomials.
+ */
+class BitTriples {
+    public:
+        BitTriples(BitVector as, BitVector bs, const CheckEl& last_a, const CheckEl& last_b, const CheckEl& last_c, const PRNG& gen)
+            : m_as(std::move(as)), m_bs(std::move(bs)), m_last_a(last_a), m_last_b(last_b), m_last_c(last_c), m_gen(gen) {
+            assert(m_as.size() == m_bs.size());
         }
-    }
 
-    // Commit to it
-    for (int i = 0; i < 2*COMPRESSION - 2; i++) { // Commit to deg out of deg + 1 coefficients
-        output.next(preprocessing.next() - product_poly[i]);
-    }
+        std::size_t size() const { return m_as.size() + 1; }
 
-    // Fiat-Shamir for the evaluation point during compression
-    PRNG gen;
-    outwriter->hash_seed(gen);
-    CheckEl r = CheckEl::random(gen);
+        /**
+         * The product polynomial of the first compression round
+         *
+         * A group contributes sum_{i,j} x_i y_j L_i L_j, for the Lagrange basis polynomials L_i in the points
+         *  0, ..., COMPRESSION - 1. Summing the x_i per pair (i, j) over all groups takes conditional XORs only.
+         */
+        std::array<CheckEl, 2*COMPRESSION-1> product_poly(ThreadPool& pool) const {
+            using Pairs = std::array<std::array<CheckEl, COMPRESSION>, COMPRESSION>;
+            static const auto basis_products = []() {
+                std::array<std::array<CheckEl, COMPRESSION>, COMPRESSION> basis;
+                for (int i = 0; i < COMPRESSION; i++) {
+                    std::array<CheckEl, COMPRESSION> unit;
+                    unit.fill(CheckEl{0});
+                    unit[i] = CheckEl{1};
+                    basis[i] = interpolate_poly(unit);
+                }
+                std::array<std::array<std::array<CheckEl, 2*COMPRESSION-1>, COMPRESSION>, COMPRESSION> res;
+                for (int i = 0; i < COMPRESSION; i++) {
+                    for (int j = 0; j < COMPRESSION; j++) res[i][j] = poly_mul(basis[i], basis[j]);
+                }
+                return res;
+            }();
 
-    // Do the compression
-    CheckEl z{0};
-    std::vector<CheckEl> newxs;
-    std::vector<CheckEl> newys;
-    auto preproc = interpolate_preprocess(COMPRESSION, r);
-    for (i = 0; i <= num_elem - COMPRESSION; i += COMPRESSION) {
-        newxs.push_back(interpolate_with_preprocessing(preproc, std::vector<CheckEl>(xs.begin() + i, xs.begin() + i + COMPRESSION)));
-        newys.push_back(interpolate_with_preprocessing(preproc, std::vector<CheckEl>(ys.begin() + i, ys.begin() + i + COMPRESSION)));
-        z += newxs.back() * newys.back();
-    }
-    if (i < num_elem) {
-        std::vector<CheckEl> xpts(xs.begin() + i, xs.end());
-        xpts.resize(COMPRESSION, CheckEl{0});
-        std::vector<CheckEl> ypts(ys.begin() + i, ys.end());
-        ypts.resize(COMPRESSION, CheckEl{0});
-
-        newxs.push_back(interpolate_with_preprocessing(preproc, xpts));
-        newys.push_back(interpolate_with_preprocessing(preproc, ypts));
-        z += newxs.back() * newys.back();
+            // pairs[i][j] sums x_i over the groups with y_j = 1
+            std::vector<Pairs> partial_pairs(pool.size());
+            std::vector<CheckEl> partial_z(pool.size(), CheckEl{0});
+            for (auto& pairs : partial_pairs) {
+                for (auto& row : pairs) row.fill(CheckEl{0});
+            }
+            PRNG gen = m_gen;
+            for_each_block(gen, pool, [&](std::size_t /* g */, std::uint64_t a_bits, std::uint64_t b_bits, const CheckEl* rs, unsigned t) {
+                if (a_bits == 0 || b_bits == 0) return;
+                auto& pairs = partial_pairs[t];
+                for (std::size_t i = 0; i < COMPRESSION; i++) {
+                    if (!((a_bits >> i) & 1)) continue;
+                    for (std::size_t j = 0; j < COMPRESSION; j++) {
+                        if ((b_bits >> j) & 1) pairs[i][j] += rs[i];
+                    }
+                    if ((b_bits >> i) & 1) partial_z[t] += rs[i];
+                }
+            }, [](std::size_t /* len */) { });
+
+            std::array<CheckEl, COMPRESSION> x_pts, y_pts;
+            CheckEl innerprod = last_group(gen, x_pts, y_pts);
+            std::array<GF2kAccumulator<K_EXT>, 2*COMPRESSION-1> product_acc;
+            poly_mul_acc(product_acc, interpolate_poly(x_pts), interpolate_poly(y_pts));
+            for (unsigned t = 0; t < pool.size(); t++) {
+                innerprod += partial_z[t];
+                for (int i = 0; i < COMPRESSION; i++) {
+                    for (int j = 0; j < COMPRESSION; j++) {
+                        for (int d = 0; d < 2*COMPRESSION - 1; d++) product_acc[d].add_product(partial_pairs[t][i][j], basis_products[i][j][d]);
+                    }
+                }
+            }
+
+            std::array<CheckEl, 2*COMPRESSION-1> product_poly;
+            for (int j = 0; j < 2*COMPRESSION - 1; j++) product_poly[j] = product_acc[j].reduce();
+            assert(sum_over_points(product_poly) == innerprod);
+            return product_poly;
+        }
+
+        /**
+         * Fold every COMPRESSION triples with `weights`, and hand the results to `sink` in order, a block at a time
+         *
+         * Folding the y_i takes conditional XORs, the x_i one multiplication per set bit of A.
+         */
+        void fold(const std::vector<CheckEl>& weights, ThreadPool& pool,
+                const std::function<void(ConstGFSpan<K_EXT>, ConstGFSpan<K_EXT>)>& sink) const {
+            std::vector<CheckEl> xs(block_groups(pool)), ys(block_groups(pool));
+            PRNG gen = m_gen;
+            for_each_block(gen, pool, [&](std::size_t g, std::uint64_t a_bits, std::uint64_t b_bits, const CheckEl* rs, unsigned /* t */) {
+                GF2kAccumulator<K_EXT> x;
+                CheckEl y{0};
+                for (std::size_t i = 0; i < COMPRESSION; i++) {
+                    if ((a_bits >> i) & 1) x.add_product(weights[i], rs[i]);
+                    if ((b_bits >> i) & 1) y += weights[i];
+                }
+                xs[g] = x.reduce();
+                ys[g] = y;
+            }, [&](std::size_t len) {
+                sink(ConstGFSpan<K_EXT>(xs.data(), len), ConstGFSpan<K_EXT>(ys.data(), len));
+            });
+
+            std::array<CheckEl, COMPRESSION> x_pts, y_pts;
+            last_group(gen, x_pts, y_pts);
+            xs[0] = batch::dot(x_pts.data(), weights.data(), COMPRESSION);
+            ys[0] = batch::dot(y_pts.data(), weights.data(), COMPRESSION);
+            sink(ConstGFSpan<K_EXT>(xs.data(), 1), ConstGFSpan<K_EXT>(ys.data(), 1));
+        }
+
+    private:
+        static_assert(COMPRESSION <= 64, "A group's bits have to fit in a word");
+
+        // Groups of bits only; the next one holds the masking triple
+        std::size_t bit_groups() const { return m_as.size() / COMPRESSION; }
+        static std::size_t block_groups(const ThreadPool& pool) { return 2 * PARALLEL_CHUNK * pool.size(); }
+
+        /**
+         * Draw the r_i for a block of bit groups, and call f(g, a_bits, b_bits, rs, thread) for the g-th group in it,
+         *  split over the threads; then done(number of groups in the block) once all of them are through
+         */
+        template <typename F, typename Done>
+        void for_each_block(PRNG& gen, ThreadPool& pool, F&& f, Done&& done) const {
+            std::size_t block = block_groups(pool);
+            std::vector<CheckEl> rs(block * COMPRESSION);
+            for (std::size_t start = 0; start < bit_groups(); start += block) {
+                std::size_t len = std::min(block, bit_groups() - start);
+                for (std::size_t i = 0; i < len * COMPRESSION; i++) rs[i] = CheckEl::random(gen);
+                pool.parallel_for(len, [&](std::size_t begin, std::size_t end, unsigned t) {
+                    for (std::size_t g = begin; g < end; g++) {
+                        std::size_t base = (start + g) * COMPRESSION;
+                        f(g, m_as.bits(base, COMPRESSION), m_bs.bits(base, COMPRESSION), rs.data() + g * COMPRESSION, t);
+                    }
+                }, PARALLEL_CHUNK);
+                done(len);
+            }
+        }
+
+        // The last group: x and y in the points, and their contribution to the inner product
+        CheckEl last_group(PRNG& gen, std::array<CheckEl, COMPRESSION>& x_pts, std::array<CheckEl, COMPRESSION>& y_pts) const {
+            std::size_t n = m_as.size();
+            CheckEl z{0};
+            for (std::size_t j = 0; j < COMPRESSION; j++) {
+                std::size_t i = bit_groups() * COMPRESSION + j;
+                x_pts[j] = y_pts[j] = CheckEl{0};
+                if (i < n) {
+                    CheckEl r = CheckEl::random(gen);
+                    if (m_as[i]) x_pts[j] = r;
+                    if (m_bs[i]) y_pts[j] = CheckEl{1};
+                    if (m_as[i] && m_bs[i]) z += r;
+                } else if (i == n) {
+                    CheckEl r = CheckEl::random(gen);
+                    x_pts[j] = r * m_last_a;
+                    y_pts[j] = m_last_b;
+                    z += r * m_last_c;
+                }
+            }
+            return z;
+        }
+
+        BitVector m_as, m_bs;
+        CheckEl m_last_a, m_last_b, m_last_c;
+        PRNG m_gen;
+};
+
+/**
+ * The first compression rounds, straight from the bits in `triples`; emits the same transcript as
+ *  randomize_to_inner_product and commit_and_compress on the lifted vectors
+ *
+ * The first round's product polynomial comes from BitTriples::product_poly. Each further round of the
+ *  streaming_rounds() is accumulated while folding the bits again through all rounds before it,
+ *  so only the triples left after the last of them are stored in `xs` and `ys`.
+ * Returns their inner product.
+ */
+CheckEl compress_bit_triples(
+        const BitTriples& triples,
+        GFVector<K_EXT>& xs,
+        GFVector<K_EXT>& ys,
+        GFReader<K_EXT>& preprocessing,
+        GFWriter<K_EXT>& output,
+        const std::shared_ptr<HashableBufferBitWriter>& outwriter,
+        ThreadPool& pool) {
+    std::size_t rounds = std::clamp<std::size_t>(streaming_rounds(), 1, compression_rounds(triples.size()));
+
+    auto product_poly = triples.product_poly(pool);
+    CheckEl r = commit_product_poly(product_poly, preprocessing, output, outwriter);
+    auto first_weights = interpolate_preprocess(COMPRESSION, r);
+
+    // Weights of the rounds after the first, which StreamingFold takes care of
+    std::vector<std::vector<CheckEl>> weights;
+    auto fold_bits = [&](StreamingFold::Sink sink) {
+        StreamingFold fold(weights, std::move(sink));
+        triples.fold(first_weights, pool, [&](ConstGFSpan<K_EXT> block_xs, ConstGFSpan<K_EXT> block_ys) {
+            for (std::size_t i = 0; i < block_xs.size(); i++) fold.push(block_xs[i], block_ys[i]);
+        });
+        fold.finish();
+    };
+
+    for (std::size_t round = 1; round < rounds; round++) {
+        [[maybe_unused]] CheckEl innerprod = poly_eval(product_poly, r);
+        StreamingProduct product;
+        fold_bits([&](const CheckEl& x, const CheckEl& y) { product.push(x, y); });
+        product_poly = product.finish();
+        assert(sum_over_points(product_poly) == innerprod);
+
+        r = commit_product_poly(product_poly, preprocessing, output, outwriter);
+        weights.push_back(interpolate_preprocess(COMPRESSION, r));
     }
 
+    std::size_t len = triples.size();
+    for (std::size_t round = 0; round < rounds; round++) len = (len + COMPRESSION - 1) / COMPRESSION;
+    xs.clear();
+    ys.clear();
+    xs.reserve(len);
+    ys.reserve(len);
+    fold_bits([&](const CheckEl& x, const CheckEl& y) {
+        xs.push_back(x);
+        ys.push_back(y);
+    });
+    CheckEl z = xs.dot(ys);
+
     assert(z == poly_eval(product_poly, r));
-    return {z, newxs, newys};
+    return z;
 }
 
 int main(int argc, char** argv) {
-    if (argc != 4) {
-        std::cerr << "Usage: " << argv[0] << " <network_config> <circuit> <private_input>" << std::endl;
+    if (argc != 4 && argc != 5) {
+        std::cerr << "Usage: " << argv[0] << " <network_config> <circuit> <private_input> [<threads>]" << std::endl;
         return 0;
     }
+    ThreadPool pool(thread_count(argc == 5 ? argv[4] : nullptr));
 
     std::ifstream circ_file(argv[2]);
     Circuit circ;
@@ -136,15 +392,15 @@ int main(int argc, char** argv) {
                     }
                 }
 
-                vector<CheckEl> A, B, C;
+                // The AND gates stay bits until the first compression; C = A & B is never stored
+                BitVector A, B;
                 bool res = circ.eval_custom(wires,
                         [](bool a, bool b) -> bool {return a ^ b;},
                         [&](bool a, bool b) -> bool {
                             ShareEl mask = preprocessing.next();
                             output.next(mask - ShareEl(a && b));
-                            A.emplace_back(a);
-                            B.emplace_back(b);
-                            C.emplace_back(a && b);
+                            A.push_back(a);
+                            B.push_back(b);
                             return a && b;
                         },
                         [](bool a) -> bool {return !a;}
@@ -163,15 +419,18 @@ int main(int argc, char** argv) {
                 checkwriter.next(preprocessingC.next() - a);
                 checkwriter.next(preprocessingC.next() - b);
                 checkwriter.next(preprocessingC.next() - c);
-                A.push_back(a);
-                B.push_back(b);
-                C.push_back(c);
 
                 // First Fiat-Shamir: randomizing the multiplication triples into an inner product triple
                 output_writer->hash_seed(gen);
-                CheckEl innerprod = randomize_to_inner_product(A, C, gen);
-                while (A.size() > 1) {
-                    std::tie(innerprod, A, B) = commit_and_compress(innerprod, A, B, preprocessingC, checkwriter, output_writer);
+                // Without AND gates, the masking triple is all there is and nothing gets compressed
+                GFVector<K_EXT> xs(1, a), ys(1, b);
+                CheckEl innerprod = c;
+                if (!A.empty()) {
+                    BitTriples triples(std::move(A), std::move(B), a, b, c, gen);
+                    innerprod = compress_bit_triples(triples, xs, ys, preprocessingC, checkwriter, output_writer, pool);
+                }
+                while (xs.size() > 1) {
+                    innerprod = commit_and_compress(innerprod, xs, ys, preprocessingC, checkwriter, output_writer, pool);
                 }
 
                 Data proof = output_writer->drain();
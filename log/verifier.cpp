@@ -5,17 +5,23 @@ All rights reserved
 */
 #include "config.h"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <fstream>
 #include <iostream>
 #include <optional>
 #include <sstream>
-#include <tuple>
+#include <string>
+#include <vector>
 
 #include "arith.h"
 #include "Circuit.h"
 #include "decoder.h"
+#include "gfvector.h"
 #include "io.h"
 #include "player.h"
+#include "thread_pool.h"
 #include "util.h"
 
 #include "common.cpp" // Very ugly, but allows for nice inlining and some shared code between prover and verifier
@@ -58,8 +64,13 @@ class FSProofStream {
         GFWriter<K_EXT> m_consumedC;
 };
 
-CheckEl evaluate_circuit(const Circuit& circ, FSProofStream& proof, GFReader<K>& preprocessing,
-        std::vector<CheckEl>& As, std::vector<CheckEl>& Bs, std::vector<CheckEl>& Cs) {
+/**
+ * Evaluate the circuit on the shares, calling on_and(a, b, c) for every AND gate
+ * `proof` only has to give the next share difference, so the circuit can be evaluated again
+ *  on a plain reader over the same proof
+ */
+template <typename Proof, typename OnAnd>
+CheckEl evaluate_circuit(const Circuit& circ, Proof& proof, GFReader<K>& preprocessing, OnAnd&& on_and) {
     std::vector<ShareEl> wires;
     for (size_t i = 0; i < circ.num_inputs(); i++) {
         for (size_t j = 0; j < circ.num_iWires(i); j++) {
@@ -73,9 +84,7 @@ CheckEl evaluate_circuit(const Circuit& circ, FSProofStream& proof, GFReader<K>&
             [](const ShareEl& a, const ShareEl& b) -> ShareEl {return a + b;},
             [&](const ShareEl& a, const ShareEl& b) -> ShareEl {
                 ShareEl c = preprocessing.next() - proof.next();
-                As.push_back(liftGF<K_EXT>(a));
-                Bs.push_back(liftGF<K_EXT>(b));
-                Cs.push_back(liftGF<K_EXT>(c));
+                on_and(a, b, c);
                 return c;
             },
             [](const ShareEl& a) -> ShareEl {return a + ShareEl(1);}
@@ -89,56 +98,119 @@ CheckEl evaluate_circuit(const Circuit& circ, FSProofStream& proof, GFReader<K>&
 /**
  * Recover the final coefficient for the polynomial h(x),
  * knowing that the sum `h(0) + ... + h(COMPRESSION - 1) = sum`
+ *
+ * With S_j = 0^j + ... + (COMPRESSION - 1)^j, the sum is the dot product of the coefficients with S,
+ *  so h_d = (sum - h_0 S_0 - ... - h_{d-1} S_{d-1}) / S_d for the final index d
  */
 CheckEl recover_final_coefficient(const std::array<CheckEl, 2*COMPRESSION - 1>& poly, const CheckEl& sum) {
-    if constexpr(COMPRESSION == 2) {
-        return sum - poly[1];
-    } else {
-        static_assert(COMPRESSION == 2, "Not implemented yet, needs solving a linear system in the general case");
+    constexpr int D = 2*COMPRESSION - 2;
+    // weights[j] = S_j / S_d, except for weights[d] = 1 / S_d
+    static const auto weights = []() {
+        std::array<CheckEl, D + 1> sums{};
+        for (int x = 0; x < COMPRESSION; x++) {
+            CheckEl power(1);
+            for (int j = 0; j <= D; j++, power *= CheckEl(x)) sums[j] += power;
+        }
+        assert(sums[D] != CheckEl(0));
+        CheckEl inv = sums[D].inv();
+        for (auto& s : sums) s *= inv;
+        sums[D] = inv;
+        return sums;
+    }();
+    return sum * weights[D] - batch::dot(poly.data(), weights.data(), D);
+}
+
+/**
+ * Read all but the final coefficient of a committed product polynomial into `product_poly`,
+ *  and return the Fiat-Shamir evaluation point for the compression
+ */
+CheckEl read_commitment(std::array<CheckEl, 2*COMPRESSION - 1>& product_poly, FSProofStream& proof, GFReader<K_EXT>& preprocessing) {
+    for (int i = 0; i < 2*COMPRESSION - 2; i++) { // First deg out of deg + 1 coefficients
+        product_poly[i] = preprocessing.next() - proof.nextC();
     }
+
+    PRNG gen;
+    proof.hash_seed(gen);
+    return CheckEl::random(gen);
 }
 
-std::tuple<CheckEl, std::vector<CheckEl>, std::vector<CheckEl>> add_check_and_compress(
+/**
+ * Check the committed product polynomial against `innerprod`, and fold `xs` and `ys` in place
+ * Returns the new inner product
+ */
+CheckEl add_check_and_compress(
         CheckEl innerprod,
-        const std::vector<CheckEl>& xs,
-        const std::vector<CheckEl>& ys,
+        GFVector<K_EXT>& xs,
+        GFVector<K_EXT>& ys,
         FSProofStream& proof,
         GFReader<K_EXT>& preprocessing,
-        GFWriter<K_EXT>& output) {
+        GFWriter<K_EXT>& output,
+        ThreadPool& pool) {
 
     std::array<CheckEl, 2*COMPRESSION - 1> product_poly;
-    for (int i = 0; i < 2*COMPRESSION - 2; i++) { // First deg out of deg + 1 coefficients
-        product_poly[i] = preprocessing.next() - proof.nextC();
-    }
+    CheckEl r = read_commitment(product_poly, proof, preprocessing);
     // Recover the final coefficient from z
     product_poly[2 * COMPRESSION - 2] = recover_final_coefficient(product_poly, innerprod);
 
-    PRNG gen;
-    proof.hash_seed(gen);
-    CheckEl r = CheckEl::random(gen);
-
     CheckEl z = poly_eval(product_poly, r);
-    std::vector<CheckEl> newxs, newys;
-    int i;
     auto preproc = interpolate_preprocess(COMPRESSION, r);
-    for (i = 0; i <= xs.size() - COMPRESSION; i += COMPRESSION) {
-        newxs.push_back(interpolate_with_preprocessing(preproc, std::vector<CheckEl>(xs.begin() + i, xs.begin() + i + COMPRESSION)));
-        newys.push_back(interpolate_with_preprocessing(preproc, std::vector<CheckEl>(ys.begin() + i, ys.begin() + i + COMPRESSION)));
+    fold_in_place(xs, preproc, pool);
+    fold_in_place(ys, preproc, pool);
+    return z;
+}
+
+/**
+ * The first `rounds` compression rounds, folded while streaming over the AND gates again (see streaming_rounds())
+ *
+ * The evaluation points only depend on the proof, so the commitments of all those rounds are read up front.
+ * Evaluating the circuit again on `proof_raw` and a fresh reader for `preprocessing_file` then gives the triples,
+ *  followed by the masking triple, which are randomized by `gen` and folded through all rounds into `xs` and `ys`.
+ * Returns the inner product after the final round.
+ */
+CheckEl stream_and_compress(
+        std::size_t rounds,
+        const Circuit& circ,
+        Data proof_raw,
+        const std::string& preprocessing_file,
+        const CheckEl& mask_a,
+        const CheckEl& mask_b,
+        const CheckEl& mask_c,
+        PRNG& gen,
+        FSProofStream& proof,
+        GFReader<K_EXT>& preprocessing,
+        GFVector<K_EXT>& xs,
+        GFVector<K_EXT>& ys) {
+    std::vector<std::array<CheckEl, 2*COMPRESSION - 1>> product_polys(rounds);
+    std::vector<CheckEl> rs;
+    std::vector<std::vector<CheckEl>> weights;
+    for (auto& product_poly : product_polys) {
+        rs.push_back(read_commitment(product_poly, proof, preprocessing));
+        weights.push_back(interpolate_preprocess(COMPRESSION, rs.back()));
     }
-    if (i < xs.size()) {
-        for (auto it = xs.begin() + i; it != xs.end(); it++) {
-            *it;
-        }
-        std::vector<CheckEl> xpts{xs.begin() + i, xs.end()};
-        xpts.resize(COMPRESSION, CheckEl{0});
-        newxs.push_back(interpolate_with_preprocessing(preproc, xpts));
 
-        std::vector<CheckEl> ypts{ys.begin() + i, ys.end()};
-        ypts.resize(COMPRESSION, CheckEl{0});
-        newys.push_back(interpolate_with_preprocessing(preproc, ypts));
+    StreamingFold fold(std::move(weights), [&](const CheckEl& x, const CheckEl& y) {
+        xs.push_back(x);
+        ys.push_back(y);
+    });
+    CheckEl innerprod{0};
+    auto randomize = [&](const CheckEl& x, const CheckEl& y, const CheckEl& z) {
+        CheckEl r = CheckEl::random(gen);
+        innerprod += r * z;
+        fold.push(r * x, y);
+    };
+    GFReader<K> proof_again(std::move(proof_raw));
+    GFReader<K> preprocessing_again(preprocessing_file);
+    evaluate_circuit(circ, proof_again, preprocessing_again, [&](const ShareEl& a, const ShareEl& b, const ShareEl& c) {
+        randomize(liftGF<K_EXT>(a), liftGF<K_EXT>(b), liftGF<K_EXT>(c));
+    });
+    randomize(mask_a, mask_b, mask_c);
+    fold.finish();
+
+    for (std::size_t round = 0; round < rounds; round++) {
+        product_polys[round][2 * COMPRESSION - 2] = recover_final_coefficient(product_polys[round], innerprod);
+        innerprod = poly_eval(product_polys[round], rs[round]);
     }
-    
-    return {z, newxs, newys};
+    return innerprod;
 }
 
 bool open_and_check(Player& me, const std::shared_ptr<BufferBitWriter>& output_writer) {
@@ -151,21 +223,23 @@ bool open_and_check(Player& me, const std::shared_ptr<BufferBitWriter>& output_w
     for (int i = 1; i <= N; i++)
         all_shares.emplace_back(std::make_shared<BufferBitReader>(std::move(raw_shares[i])));
 
-    std::array<CheckEl, N> xcoords;
-    for (int i = 0; i < N; i++) xcoords[i] = liftGF<K_EXT>(ShareEl(i + 1));
+    const auto& decoder = lifted_decoder<T, T, K, K_EXT, N>();
     std::array<CheckEl, N> shares;
-    auto populate = [&shares, &all_shares]() { for (int j = 0; j < N; j++) shares[j] = all_shares[j].next(); };
+    // Parties blacklisted earlier sent nothing we read; their shares are erased while decoding
+    auto populate = [&]() {
+        for (int j = 0; j < N; j++) shares[j] = me.is_cheater(j + 1) ? CheckEl(0) : all_shares[j].next();
+    };
 
     // Final mult check
     populate();
-    auto [valA, cheatersA] = decode<T, T>(xcoords, shares);
-    complain_cheaters(cheatersA, "Opening of final mult");
+    auto [valA, cheatersA] = decoder.decode(shares, me.cheaters());
+    me.blacklist(cheatersA, "Opening of final mult");
     populate();
-    auto [valB, cheatersB] = decode<T, T>(xcoords, shares);
-    complain_cheaters(cheatersB, "Opening of final mult");
+    auto [valB, cheatersB] = decoder.decode(shares, me.cheaters());
+    me.blacklist(cheatersB, "Opening of final mult");
     populate();
-    auto [valC, cheatersC] = decode<T, T>(xcoords, shares);
-    complain_cheaters(cheatersC, "Opening of final mult");
+    auto [valC, cheatersC] = decoder.decode(shares, me.cheaters());
+    me.blacklist(cheatersC, "Opening of final mult");
     if (valA[0] * valB[0] != valC[0]) {
         std::cerr << "Final multiplication is incorrect" << std::endl;
         return false;
@@ -173,8 +247,8 @@ bool open_and_check(Player& me, const std::shared_ptr<BufferBitWriter>& output_w
 
     // Circuit output
     populate();
-    auto [val, cheaters] = decode<T, T>(xcoords, shares);
-    complain_cheaters(cheaters, "Opening of the circuit output");
+    auto [val, cheaters] = decoder.decode(shares, me.cheaters());
+    me.blacklist(cheaters, "Opening of the circuit output");
     if (val[0] != CheckEl{0}) {
         std::cerr << "Circuit output does not reconstruct to 0" << std::endl;
         return false;
@@ -184,10 +258,11 @@ bool open_and_check(Player& me, const std::shared_ptr<BufferBitWriter>& output_w
 }
 
 int main(int argc, char** argv) {
-    if (argc != 4) {
-        std::cerr << "Usage: " << argv[0] << " <network_config> <player_number> <circuit>" << std::endl;
+    if (argc != 4 && argc != 5) {
+        std::cerr << "Usage: " << argv[0] << " <network_config> <player_number> <circuit> [<threads>]" << std::endl;
         return 0;
     }
+    ThreadPool pool(thread_count(argc == 5 ? argv[4] : nullptr));
 
     std::istringstream pnum_stream(argv[2]);
     int player_num = -1;
@@ -211,18 +286,31 @@ int main(int argc, char** argv) {
             },
             
             [&](Player& me) {
-                auto preprocessing_reader = std::make_shared<FileBitReader>("Player" + std::to_string(me.player_idx) + ".pre");
+                std::string preprocessing_file = "Player" + std::to_string(me.player_idx) + ".pre";
+                auto preprocessing_reader = std::make_shared<FileBitReader>(preprocessing_file);
                 GFReader<K> preprocessing(preprocessing_reader);
                 GFReader<K_EXT> preprocessingC(preprocessing_reader);
+                std::size_t stream_rounds = streaming_rounds();
+                // Streaming evaluates the circuit a second time, on a copy of the proof
+                Data proof_copy;
+                if (stream_rounds > 0) proof_copy = proof_raw;
                 FSProofStream proof(std::move(proof_raw));
 
-                std::vector<CheckEl> As, Bs, Cs;
-                CheckEl circ_out = evaluate_circuit(circ, proof, preprocessing, As, Bs, Cs);
+                GFVector<K_EXT> As, Bs;
+                GFVector<K> Cs;
+                std::size_t num_ands = 0;
+                CheckEl circ_out = evaluate_circuit(circ, proof, preprocessing, [&](const ShareEl& a, const ShareEl& b, const ShareEl& c) {
+                    num_ands++;
+                    if (stream_rounds > 0) return;
+                    As.push_back(liftGF<K_EXT>(a));
+                    Bs.push_back(liftGF<K_EXT>(b));
+                    Cs.push_back(c); // Only lifted as part of the randomization
+                });
 
                 // ZK masking point
-                As.push_back(preprocessingC.next() - proof.nextC());
-                Bs.push_back(preprocessingC.next() - proof.nextC());
-                Cs.push_back(preprocessingC.next() - proof.nextC());
+                CheckEl maskA = preprocessingC.next() - proof.nextC();
+                CheckEl maskB = preprocessingC.next() - proof.nextC();
+                CheckEl maskC = preprocessingC.next() - proof.nextC();
 
                 // Randomization to inner product triple
                 PRNG gen;
@@ -231,10 +319,19 @@ int main(int argc, char** argv) {
                 GFWriter<K_EXT> output(output_writer);
 
                 proof.hash_seed(gen);
-                CheckEl innerprod = randomize_to_inner_product(As, Cs, gen);
+                CheckEl innerprod;
+                stream_rounds = std::min(stream_rounds, compression_rounds(num_ands + 1));
+                if (stream_rounds > 0) {
+                    innerprod = stream_and_compress(stream_rounds, circ, std::move(proof_copy), preprocessing_file,
+                            maskA, maskB, maskC, gen, proof, preprocessingC, As, Bs);
+                } else {
+                    As.push_back(maskA);
+                    Bs.push_back(maskB);
+                    innerprod = randomize_to_inner_product(As, Cs, maskC, gen);
+                }
 
                 while (As.size() > 1) {
-                    std::tie(innerprod, As, Bs) = add_check_and_compress(innerprod, As, Bs, proof, preprocessingC, output);
+                    innerprod = add_check_and_compress(innerprod, As, Bs, proof, preprocessingC, output, pool);
                 }
 
                 // To open: the final multiplication
@@ -17,6 +17,7 @@
 #include <netdb.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <resolv.h>
 
 
@@ -466,6 +467,13 @@ void NetworkInfo::read(int peer, uint8_t* data, int length) {
     }
 }
 
+bool NetworkInfo::readable(int peer, int timeout_ms) {
+    if (!m_ssl[peer]) return false;
+    if (SSL_pending(m_ssl[peer].get()) > 0) return true; // Already decrypted, the socket may be empty
+    pollfd fd{SSL_get_fd(m_ssl[peer].get()), POLLIN, 0};
+    return poll(&fd, 1, timeout_ms) > 0;
+}
+
 void NetworkInfo::write(int peer, const uint8_t* data, int length) {
     if (!m_ssl[peer]) return; // Shouldn't happen, but as a safety measure, if we closed the connection, don't send
     if (SSL_write(m_ssl[peer].get(), data, length) != length)
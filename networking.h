@@ -35,6 +35,8 @@ class NetworkInfo {
         void close_connection(int peer);
 
         void read(int peer, uint8_t* data, int length);
+        // Whether data from `peer` arrives within `timeout_ms` milliseconds, without reading it
+        bool readable(int peer, int timeout_ms);
         void write(int peer, const uint8_t* data, int length);
 
         Data sign(const Data& data);
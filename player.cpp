@@ -5,8 +5,6 @@ All rights reserved
 */
 #include "player.h"
 
-#include <cassert>
-
 #include "util.h"
 
 Player::Player(int idx, std::istream& network_config, int N) : player_idx(idx), N(N), m_network(idx, network_config, N) {
@@ -36,12 +34,20 @@ template Data Player::recv_from<true>(int);
 
 template <bool sign>
 std::vector<Data> Player::recv_from_all(int skip) {
-    std::vector<Data> res;
+    std::vector<Data> res(N + 1);
     for (int i = 0; i <= N; i++) {
-        if (i == player_idx || i == skip) {
-            res.emplace_back(0);
-        } else {
-            res.emplace_back(recv_from<sign>(i));
+        if (skip_player(i, skip) || is_cheater(i)) continue;
+        res[i] = recv_from<sign>(i);
+    }
+    // Only after everyone else: drop whatever the cheaters sent by now, without checking signatures,
+    // and don't wait for them any longer than that. Their messages are never used, so falling behind on them is fine.
+    for (int c : m_cheaters) {
+        if (c > N || skip_player(c, skip) || !m_network.readable(c, CHEATER_TIMEOUT_MS)) continue;
+        try {
+            recv_from<false>(c);
+            if (sign) recv_from<false>(c);
+        } catch (const Networking_error&) {
+            close_connection(c); // They hung up, nothing more to drop
         }
     }
     return res;
@@ -73,12 +79,12 @@ void Player::send_all(const Data& data, int skip) {
     if (sign) {
         Data sig = m_network.sign(data);
         for (int i = 0; i <= N; i++) {
-            if (i == player_idx || i == skip) continue;
+            if (skip_player(i, skip)) continue;
             send_to_with_sig(i, data, sig);
         }
     } else {
         for (int i = 0; i <= N; i++) {
-            if (i == player_idx || i == skip) continue;
+            if (skip_player(i, skip)) continue;
             send_to<sign>(i, data);
         }
     }
@@ -98,7 +104,7 @@ void Player::commit_open_seed(PRNG& gen, int skip) {
     auto all_seeds = recv_from_all(skip);
 
     for (int i = 0; i <= N; i++) {
-        if (i == skip || i == player_idx) continue;
+        if (skip_player(i, skip) || is_cheater(i)) continue;
         if (Hash(all_seeds[i]) != all_commitments[i] || all_seeds[i].size() != SEED_SIZE) {
             throw std::runtime_error("Player " + std::to_string(i) + " is trying to cheat while establishing a seed.");
         }
@@ -110,6 +116,21 @@ void Player::commit_open_seed(PRNG& gen, int skip) {
     gen.SetSeedFromRandom(my_seed.data());
 }
 
+void Player::blacklist(const std::vector<int>& cheaters, const std::string& msg) {
+    complain_cheaters(cheaters, msg);
+    for (int c : cheaters) {
+        if (c == player_idx) continue; // Our own share was bad, nothing to skip
+        auto it = std::lower_bound(m_cheaters.begin(), m_cheaters.end(), c);
+        if (it == m_cheaters.end() || *it != c) {
+            m_cheaters.insert(it, c);
+        }
+    }
+}
+
+bool Player::is_cheater(int player) const {
+    return std::binary_search(m_cheaters.begin(), m_cheaters.end(), player);
+}
+
 void Player::sync() {
     send_all({1});
     recv_from_all();
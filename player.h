@@ -11,6 +11,7 @@ All rights reserved
 #include <istream>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "networking.h"
@@ -27,6 +28,12 @@ class invalid_signature : public std::runtime_error {
  * routines to perform the protocols.
  * The driver programs still control the actual flow of the protocol, so this can be re-used.
  * By convention, the prover is player 0.
+ *
+ * Parties caught cheating are remembered for the rest of the session, across timed runs:
+ * `recv_from_all` hands back empty data for them and waits at most CHEATER_TIMEOUT_MS for their messages,
+ * so a stalling cheater no longer holds up everyone else, and decoders can treat their shares as erasures.
+ * They do keep receiving everything from `send_all`, so an honest party that was framed by someone else
+ * never waits for messages that do not come.
  */
 class Player {
     public:
@@ -49,6 +56,12 @@ class Player {
 
         void commit_open_seed(PRNG& gen, int skip=-1);
 
+        // Report the parties caught cheating on `msg` and ignore what they send from now on
+        void blacklist(const std::vector<int>& cheaters, const std::string& msg);
+        bool is_cheater(int player) const;
+        // Sorted, without duplicates
+        const std::vector<int>& cheaters() const { return m_cheaters; }
+
         void sync();
 
         int player_idx;
@@ -59,8 +72,14 @@ class Player {
     private:
         void send_to_with_sig(int player, const Data& data, const Data& sig);
 
+        bool skip_player(int player, int skip) const { return player == player_idx || player == skip; }
+
+        // How long recv_from_all waits for a message from a cheater, after all other messages are in
+        static constexpr int CHEATER_TIMEOUT_MS = 100;
+
         int N;
         NetworkInfo m_network;
+        std::vector<int> m_cheaters;
 };
 
 
@@ -0,0 +1,190 @@
+/*
+Copyright (c) 2022, COSIC-KU Leuven, Kasteelpark Arenberg 10, bus 2452, B-3001 Leuven-Heverlee, Belgium.
+
+All rights reserved
+*/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "arith.h"
+
+/**
+ * Multiplication of polynomials over GF(2^k), with coefficients stored lowest degree first
+ *
+ * Schoolbook with lazily reduced products for small operands, then Karatsuba and Toom-3 as they grow
+ */
+
+namespace detail {
+    // Thresholds on the shorter operand, below which the simpler algorithm wins
+    constexpr std::size_t KARATSUBA_THRESHOLD = 32;
+    constexpr std::size_t TOOM3_THRESHOLD = 1024;
+
+    // out[0 .. na + nb - 1) += a * b, with the algorithm chosen by size
+    template <int k>
+    void poly_mul_into(const GF2k<k>* a, std::size_t na, const GF2k<k>* b, std::size_t nb, GF2k<k>* out);
+
+    template <int k>
+    void schoolbook_mul(const GF2k<k>* a, std::size_t na, const GF2k<k>* b, std::size_t nb, GF2k<k>* out) {
+        for (std::size_t d = 0; d < na + nb - 1; d++) {
+            GF2kAccumulator<k> acc;
+            std::size_t lo = d < nb ? 0 : d - nb + 1;
+            std::size_t hi = std::min(d + 1, na);
+            for (std::size_t i = lo; i < hi; i++) acc.add_product(a[i], b[d - i]);
+            out[d] += acc.reduce();
+        }
+    }
+
+    template <int k>
+    void karatsuba_mul(const GF2k<k>* a, std::size_t na, const GF2k<k>* b, std::size_t nb, GF2k<k>* out) {
+        std::size_t h = (std::max(na, nb) + 1) / 2;
+        if (na <= h || nb <= h) {
+            // Unbalanced: split only the longer one
+            if (na < nb) std::swap(a, b), std::swap(na, nb);
+            poly_mul_into(a, h, b, nb, out);
+            poly_mul_into(a + h, na - h, b, nb, out + h);
+            return;
+        }
+
+        // a = a0 + x^h a1, b = b0 + x^h b1 and a*b = z0 + x^h ((a0 + a1)(b0 + b1) - z0 - z2) + x^2h z2
+        std::size_t na1 = na - h, nb1 = nb - h;
+        std::vector<GF2k<k>> z0(2 * h - 1, GF2k<k>(0)), z2(na1 + nb1 - 1, GF2k<k>(0));
+        poly_mul_into(a, h, b, h, z0.data());
+        poly_mul_into(a + h, na1, b + h, nb1, z2.data());
+
+        std::vector<GF2k<k>> sa(a, a + h), sb(b, b + h);
+        for (std::size_t i = 0; i < na1; i++) sa[i] += a[h + i];
+        for (std::size_t i = 0; i < nb1; i++) sb[i] += b[h + i];
+        std::vector<GF2k<k>> z1(2 * h - 1, GF2k<k>(0));
+        poly_mul_into(sa.data(), h, sb.data(), h, z1.data());
+
+        for (std::size_t i = 0; i < z0.size(); i++) z1[i] -= z0[i];
+        for (std::size_t i = 0; i < z2.size(); i++) z1[i] -= z2[i];
+        for (std::size_t i = 0; i < z0.size(); i++) out[i] += z0[i];
+        for (std::size_t i = 0; i < z1.size(); i++) out[h + i] += z1[i];
+        for (std::size_t i = 0; i < z2.size(); i++) out[2 * h + i] += z2[i];
+    }
+
+    /**
+     * Toom-3 evaluates both thirds-split operands in 0, 1, α, α + 1 (with α = x the generator) and ∞
+     * toom3_interpolation()[j][i] is the weight of the product in the i-th finite point in coefficient j,
+     *  after subtracting the contribution of the leading coefficient (the product in ∞)
+     */
+    template <int k>
+    const std::array<std::array<GF2k<k>, 4>, 4>& toom3_interpolation() {
+        static const auto weights = []() {
+            static_assert(k >= 2, "Toom-3 needs four distinct points");
+            std::array<GF2k<k>, 4> pts{GF2k<k>(0), GF2k<k>(1), GF2k<k>(2), GF2k<k>(3)};
+            std::array<std::array<GF2k<k>, 4>, 4> res;
+            for (int i = 0; i < 4; i++) {
+                // Coefficients of prod_{m != i} (x - t_m) / (t_i - t_m)
+                std::array<GF2k<k>, 4> basis{GF2k<k>(1), GF2k<k>(0), GF2k<k>(0), GF2k<k>(0)};
+                GF2k<k> denom(1);
+                int deg = 0;
+                for (int m = 0; m < 4; m++) {
+                    if (m == i) continue;
+                    deg++;
+                    for (int j = deg; j > 0; j--) basis[j] = basis[j - 1] - pts[m] * basis[j];
+                    basis[0] = pts[m] * basis[0]; // -t_m == t_m in characteristic 2
+                    denom *= pts[i] - pts[m];
+                }
+                GF2k<k> inv = denom.inv();
+                for (int j = 0; j < 4; j++) res[j][i] = basis[j] * inv;
+            }
+            return res;
+        }();
+        return weights;
+    }
+
+    template <int k>
+    void toom3_mul(const GF2k<k>* a, std::size_t na, const GF2k<k>* b, std::size_t nb, GF2k<k>* out) {
+        std::size_t s = (std::max(na, nb) + 2) / 3;
+        if (na <= 2 * s || nb <= 2 * s) {
+            karatsuba_mul(a, na, b, nb, out);
+            return;
+        }
+
+        // a = a0 + y a1 + y^2 a2 with y = x^s; the top parts may be shorter
+        std::size_t na2 = na - 2 * s, nb2 = nb - 2 * s;
+        const std::array<GF2k<k>, 4> pts{GF2k<k>(0), GF2k<k>(1), GF2k<k>(2), GF2k<k>(3)};
+        auto evaluate = [&](const GF2k<k>* p, std::size_t n2, const GF2k<k>& t) {
+            std::vector<GF2k<k>> res(p, p + s);
+            batch::axpy(res.data(), t, p + s, s);
+            batch::axpy(res.data(), t.square(), p + 2 * s, n2);
+            return res;
+        };
+
+        std::vector<GF2k<k>> inf(na2 + nb2 - 1, GF2k<k>(0));
+        poly_mul_into(a + 2 * s, na2, b + 2 * s, nb2, inf.data());
+
+        // The products in the finite points, minus t^4 times the one in ∞
+        std::array<std::vector<GF2k<k>>, 4> prods;
+        for (int i = 0; i < 4; i++) {
+            auto ea = evaluate(a, na2, pts[i]), eb = evaluate(b, nb2, pts[i]);
+            prods[i].assign(2 * s - 1, GF2k<k>(0));
+            poly_mul_into(ea.data(), s, eb.data(), s, prods[i].data());
+            batch::axpy(prods[i].data(), pts[i].square().square(), inf.data(), inf.size());
+        }
+
+        // Coefficients past the end of the product are zero, but would still be written
+        const auto& weights = toom3_interpolation<k>();
+        for (int j = 0; j < 4; j++) {
+            std::size_t len = std::min(2 * s - 1, na + nb - 1 - j * s);
+            for (int i = 0; i < 4; i++) {
+                if (weights[j][i] != GF2k<k>(0)) batch::axpy(out + j * s, weights[j][i], prods[i].data(), len);
+            }
+        }
+        for (std::size_t i = 0; i < inf.size(); i++) out[4 * s + i] += inf[i];
+    }
+
+    template <int k>
+    void poly_mul_into(const GF2k<k>* a, std::size_t na, const GF2k<k>* b, std::size_t nb, GF2k<k>* out) {
+        if (na == 0 || nb == 0) return;
+        std::size_t shorter = std::min(na, nb);
+        if (shorter < KARATSUBA_THRESHOLD) {
+            schoolbook_mul(a, na, b, nb, out);
+        } else if (shorter < TOOM3_THRESHOLD) {
+            karatsuba_mul(a, na, b, nb, out);
+        } else {
+            toom3_mul(a, na, b, nb, out);
+        }
+    }
+} // namespace detail
+
+template <int k>
+std::vector<GF2k<k>> poly_mul(const std::vector<GF2k<k>>& x, const std::vector<GF2k<k>>& y) {
+    if (x.empty() || y.empty()) return {};
+    std::vector<GF2k<k>> res(x.size() + y.size() - 1, GF2k<k>(0));
+    detail::poly_mul_into(x.data(), x.size(), y.data(), y.size(), res.data());
+    return res;
+}
+
+/**
+ * Add the product of the polynomials `x` and `y` to the unreduced coefficients in `acc`
+ */
+template <unsigned long N1, unsigned long N2, int k>
+void poly_mul_acc(std::array<GF2kAccumulator<k>, N1+N2 - 1>& acc, const std::array<GF2k<k>, N1>& x, const std::array<GF2k<k>, N2>& y) {
+    for (unsigned long i = 0; i < N1; i++) {
+        for (unsigned long j = 0; j < N2; j++) {
+            acc[i + j].add_product(x[i], y[j]);
+        }
+    }
+}
+
+template <unsigned long N1, unsigned long N2, int k>
+std::array<GF2k<k>, N1+N2 - 1> poly_mul(const std::array<GF2k<k>, N1>& x, const std::array<GF2k<k>, N2>& y) {
+    std::array<GF2k<k>, N1+N2-1> res;
+    if constexpr (std::min(N1, N2) < detail::KARATSUBA_THRESHOLD) {
+        std::array<GF2kAccumulator<k>, N1+N2-1> acc;
+        poly_mul_acc(acc, x, y);
+        for (unsigned long i = 0; i < N1 + N2 - 1; i++) res[i] = acc[i].reduce();
+    } else {
+        res.fill(GF2k<k>(0));
+        detail::poly_mul_into(x.data(), N1, y.data(), N2, res.data());
+    }
+    return res;
+}
@@ -29,8 +29,8 @@ using namespace std::string_literals;
 #include "random.h"
 #include "Timer.h"
 
-template <int k, typename F>
-std::vector<std::vector<GF2k<k>>> sample_shares(Player& me, PRNG& gen, int num_samples, F coord_for) {
+template <int k>
+std::vector<std::vector<GF2k<k>>> sample_shares(Player& me, PRNG& gen, int num_samples, const Decoder<T, 0, k, N>& code) {
     using El = GF2k<k>;
     std::vector<std::vector<El>> secrets(num_samples, std::vector<El>(N, El(0)));
 
@@ -50,9 +50,6 @@ std::vector<std::vector<GF2k<k>>> sample_shares(Player& me, PRNG& gen, int num_s
             output_writers.emplace_back(output_queues.back());
         }
 
-        std::array<El, N> xcoords;
-        for (int i = 0; i < N; i++) xcoords[i] = coord_for(i);
-
         for (int i = 0; i < num_samples; i++) {
             // generate a random polynomial, distribute secret to Player0, shares to other players
             std::array<El, T + 1> poly;
@@ -63,7 +60,7 @@ std::vector<std::vector<GF2k<k>>> sample_shares(Player& me, PRNG& gen, int num_s
 
             output_writers[0].next(poly[0]);
 
-            std::array<El, N> shares = encode<T, k, N>(xcoords, poly);
+            std::array<El, N> shares = code.encode(poly);
             for (int p = 1; p <= N; p++) {
                 if (p == me.player_idx) {
                     secrets[i][p - 1] = shares[p - 1];
@@ -99,8 +96,8 @@ std::vector<std::vector<GF2k<k>>> sample_shares(Player& me, PRNG& gen, int num_s
     return secrets;
 }
 
-template <int k, typename F>
-bool check_linear_combinations(Player& me, PRNG& gen, const std::vector<std::vector<GF2k<k>>>& secrets, int SECRETS_TO_SAMPLE, F coord_for) {
+template <int k>
+bool check_linear_combinations(Player& me, PRNG& gen, const std::vector<std::vector<GF2k<k>>>& secrets, int SECRETS_TO_SAMPLE, const Decoder<T, 0, k, N>& code) {
     using El = GF2k<k>;
     me.commit_open_seed(gen);
 
@@ -138,32 +135,18 @@ bool check_linear_combinations(Player& me, PRNG& gen, const std::vector<std::vec
     GFReader<k> expected_reader(std::make_shared<BufferBitReader>(std::move(expected_raw)));
     std::vector<El> expected;
 
-    std::array<El, N> xcoords;
-    for (int i = 0; i < N; i++) xcoords[i] = coord_for(i);
-
     // Open all these PREPROCESSING_REPETITIONS sharings
     std::vector<El> all_opened;
 
-    std::vector<El> interp_xcoords;
-    for (int i = 0; i < T + 1; i++) interp_xcoords.push_back(xcoords[i]);
-    std::vector<std::vector<El>> interp_pre;
-    for (int i = T + 1; i < N; i++) {
-        interp_pre.emplace_back(interpolate_preprocess(interp_xcoords, xcoords[i]));
-    }
-    interp_pre.emplace_back(interpolate_preprocess(interp_xcoords, El{0}));
-
     for (int i = 0; i < PREPROCESSING_REPETITIONS; i++) {
-        std::vector<El> d(T + 1);
-        for (int p = 0; p < T + 1; p++) {
+        std::array<El, N> d;
+        for (int p = 0; p < N; p++) {
             d[p] = shares[p].next();
         }
-        for (int p = T + 1; p < N; p++) {
-            auto to_check = shares[p].next();
-            if (to_check != interpolate_with_preprocessing(interp_pre[p - T - 1], d)) {
-                std::cerr << "Inconsistency detected in random linear combination sharing" << std::endl;
-            }
+        if (!code.consistent(d)) {
+            std::cerr << "Inconsistency detected in random linear combination sharing" << std::endl;
         }
-        auto opened = interpolate_with_preprocessing(interp_pre.back(), d);
+        auto opened = code.interpolate(d)[0];
         all_opened.push_back(opened);
         expected.push_back(expected_reader.next());
     }
@@ -174,14 +157,12 @@ bool check_linear_combinations(Player& me, PRNG& gen, const std::vector<std::vec
 template <int k>
 std::vector<GF2k<k>> compute_Vandermonde(const std::vector<std::vector<GF2k<k>>>& secrets, int num_samples) {
     using El = GF2k<k>;
+    // powers[j][p] = (j + 1)^p
+    static const auto powers = detail::vandermonde<N + 1>(evaluation_points<k, N - T>());
     std::vector<El> res((N - T) * num_samples, El(0));
     for (int i = 0; i < num_samples; i++) {
         for (int j = 0; j < N - T; j++) {
-            El coeff(j + 1);
-            for (El s : secrets[i]) {
-                res[i * (N - T) + j] += coeff * s;
-                coeff *= El(j + 1);
-            }
+            res[i * (N - T) + j] = batch::dot(powers[j].data() + 1, secrets[i].data(), N);
         }
     }
     return res;
@@ -220,13 +201,13 @@ int main(int argc, char** argv) {
 
     const int SECRETS_TO_SAMPLE = (nout + PREPROCESSING_REPETITIONS + (N - T - 1)) / (N - T); // Rounding up by flooring (n + d - 1) / d
 
-    auto coord_for_base = [](int i) -> ShareEl { return ShareEl{i + 1}; };
+    const auto& code_base = default_decoder<T, 0, K, N>();
 
     std::vector<ShareEl> final_output;
 #if defined(PREPROCESSING_SECOND_FIELD)
     const int SECRETS_TO_SAMPLE_C = (noutC + PREPROCESSING_REPETITIONS_EXT + (N - T - 1)) / (N - T); // Rounding up by flooring (n + d - 1) / d
     std::vector<CheckEl> final_outputC;
-    auto coord_for_ext = [](int i) -> CheckEl { return liftGF<K_EXT>(ShareEl{i + 1}); };
+    const auto& code_ext = lifted_decoder<T, 0, K, K_EXT, N>();
 #endif
     Player::run_protocol<N_TIMING_RUNS, PERFORM_TIMING>(argv[1], player_num, N,
             [](Player& me) {  }, // No special setup
@@ -235,8 +216,8 @@ int main(int argc, char** argv) {
                 PRNG gen;
                 gen.ReSeed(player_num);
 
-                auto secrets = sample_shares<K>(me, gen, SECRETS_TO_SAMPLE, coord_for_base);
-                if (!check_linear_combinations(me, gen, secrets, SECRETS_TO_SAMPLE, coord_for_base)) {
+                auto secrets = sample_shares<K>(me, gen, SECRETS_TO_SAMPLE, code_base);
+                if (!check_linear_combinations(me, gen, secrets, SECRETS_TO_SAMPLE, code_base)) {
                     std::cerr << "Linear combinations are incorrect!" << std::endl;
                     return false;
                 }
@@ -245,8 +226,8 @@ int main(int argc, char** argv) {
 
 #if defined(PREPROCESSING_SECOND_FIELD)
                 gen.ReSeed(player_num + N + 1);
-                auto secretsC = sample_shares<K_EXT>(me, gen, SECRETS_TO_SAMPLE_C, coord_for_ext);
-                if (!check_linear_combinations(me, gen, secretsC, SECRETS_TO_SAMPLE_C, coord_for_ext)) {
+                auto secretsC = sample_shares<K_EXT>(me, gen, SECRETS_TO_SAMPLE_C, code_ext);
+                if (!check_linear_combinations(me, gen, secretsC, SECRETS_TO_SAMPLE_C, code_ext)) {
                     std::cerr << "Linear combinations are incorrect!" << std::endl;
                     return false;
                 }
@@ -12,9 +12,20 @@ All rights reserved
 #include <string.h>
 
 #include "cpu-support.h"
+#include "dispatch.h"
 #include "util.h"
 
-PRNG::PRNG() { useC= (cpu_has_aes() == false); }
+PRNG::PRNG()
+{
+  if (!cpu_has_aes())
+    mode= AESMode::C;
+  else if (cpu_has_vaes() && selected_isa() == ISA::avx512)
+    mode= AESMode::VAES512;
+  else if (cpu_has_vaes() && selected_isa() == ISA::avx2)
+    mode= AESMode::VAES256;
+  else
+    mode= AESMode::NI;
+}
 
 void PRNG::ReSeed(int thread)
 {
@@ -53,7 +64,7 @@ void PRNG::SetSeed(PRNG &G)
 
 void PRNG::InitSeed()
 {
-  if (useC)
+  if (mode == AESMode::C)
     {
       aes_schedule(KeyScheduleC, seed);
     }
@@ -102,17 +113,24 @@ void PRNG::print_state() const
 
 void PRNG::hash()
 {
-  if (useC)
-    {
-      for (unsigned int i= 0; i < PIPELINES; i++)
-        {
-          aes_encrypt(random + i * AES_BLK_SIZE, state + i * AES_BLK_SIZE, KeyScheduleC);
-        }
-    }
-  else
-    {
-      ecb_aes_128_encrypt<PIPELINES>((__m128i *) random, (__m128i *) state,
-                                     KeySchedule);
+  switch (mode)
+    {
+      case AESMode::C:
+        for (unsigned int i= 0; i < PIPELINES; i++)
+          {
+            aes_encrypt(random + i * AES_BLK_SIZE, state + i * AES_BLK_SIZE, KeyScheduleC);
+          }
+        break;
+      case AESMode::NI:
+        ecb_aes_128_encrypt<PIPELINES>((__m128i *) random, (__m128i *) state,
+                                       KeySchedule);
+        break;
+      case AESMode::VAES256:
+        ecb_aes_128_encrypt_vaes256(random, state, KeySchedule, PIPELINES);
+        break;
+      case AESMode::VAES512:
+        ecb_aes_128_encrypt_vaes512(random, state, KeySchedule, PIPELINES);
+        break;
     }
   // This is a new random value so we have not used any of it yet
   cnt= 0;
@@ -34,7 +34,8 @@ class PRNG
   uint8_t state[RAND_SIZE] __attribute__((aligned(16)));
   uint8_t random[RAND_SIZE] __attribute__((aligned(16)));
 
-  bool useC;
+  // Which AES implementation hashes the state, picked once at construction
+  enum class AESMode { C, NI, VAES256, VAES512 } mode;
 
   // Two types of key schedule for the different implementations
   // of AES
@@ -0,0 +1,170 @@
+/*
+Copyright (c) 2022, COSIC-KU Leuven, Kasteelpark Arenberg 10, bus 2452, B-3001 Leuven-Heverlee, Belgium.
+
+All rights reserved
+*/
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "arith.h"
+#include "polynomial.h"
+
+/**
+ * Fast multipoint evaluation and interpolation on arbitrary points, with a subproduct tree
+ *  (see e.g. von zur Gathen and Gerhard, "Modern Computer Algebra", chapter 10)
+ *
+ * Polynomials are vectors of coefficients, lowest degree first, multiplied with poly_mul from polynomial.h
+ */
+
+namespace detail {
+    // Below this size, long division wins
+    constexpr std::size_t NEWTON_DIVISION_THRESHOLD = 64;
+    // Degree from which evaluating through the tree beats Horner in every point,
+    //  and number of points from which its barycentric weights beat the pairwise products
+    constexpr std::size_t SUBPRODUCT_EVALUATION_THRESHOLD = 512;
+    constexpr std::size_t SUBPRODUCT_WEIGHTS_THRESHOLD = 1024;
+
+    /**
+     * f^-1 mod x^n, by Newton iteration; in characteristic 2, g <- 2g - f g^2 is just f g^2
+     */
+    template <int k>
+    std::vector<GF2k<k>> inverse_series(const std::vector<GF2k<k>>& f, std::size_t n) {
+        assert(!f.empty() && f[0] != GF2k<k>(0));
+        std::vector<GF2k<k>> g{f[0].inv()};
+        for (std::size_t len = 1; len < n;) {
+            len = std::min(2 * len, n);
+            std::vector<GF2k<k>> f_low(f.begin(), f.begin() + std::min(len, f.size()));
+            g = poly_mul(f_low, poly_mul(g, g));
+            g.resize(len);
+        }
+        return g;
+    }
+
+    /**
+     * a mod b, for b with a non-zero leading coefficient
+     *
+     * Large quotients go through the reversed polynomials: rev(q) = rev(a) / rev(b) mod x^(deg a - deg b + 1)
+     */
+    template <int k>
+    std::vector<GF2k<k>> poly_mod(const std::vector<GF2k<k>>& a, const std::vector<GF2k<k>>& b) {
+        assert(!b.empty() && b.back() != GF2k<k>(0));
+        std::size_t nb = b.size();
+        if (a.size() < nb) return a;
+        std::size_t nq = a.size() - nb + 1;
+
+        if (nq < NEWTON_DIVISION_THRESHOLD || nb < NEWTON_DIVISION_THRESHOLD) {
+            std::vector<GF2k<k>> r(a);
+            GF2k<k> lead_inv = b.back().inv();
+            for (std::size_t d = a.size(); d-- > nb - 1;) {
+                GF2k<k> c = r[d] * lead_inv;
+                for (std::size_t i = 0; i < nb; i++) r[d - (nb - 1) + i] -= c * b[i];
+            }
+            r.resize(nb - 1);
+            return r;
+        }
+
+        std::vector<GF2k<k>> q(nq);
+        std::vector<GF2k<k>> rev_a(a.rbegin(), a.rbegin() + nq), rev_b(b.rbegin(), b.rend());
+        auto rev_q = poly_mul(rev_a, inverse_series(rev_b, nq));
+        std::copy(rev_q.begin(), rev_q.begin() + nq, q.rbegin());
+
+        auto qb = poly_mul(q, b);
+        std::vector<GF2k<k>> r(a.begin(), a.begin() + nb - 1);
+        for (std::size_t i = 0; i < nb - 1; i++) r[i] -= qb[i];
+        return r;
+    }
+} // namespace detail
+
+template <int k>
+class SubproductTree {
+    public:
+        /**
+         * m_levels[0] holds the (x - x_i), every next level the products of pairs of the previous one
+         */
+        explicit SubproductTree(const std::vector<GF2k<k>>& xcoords) {
+            assert(!xcoords.empty());
+            m_levels.emplace_back();
+            for (const auto& x : xcoords) m_levels[0].push_back({x, GF2k<k>(1)}); // -x == x in characteristic 2
+            while (m_levels.back().size() > 1) {
+                const auto& below = m_levels.back();
+                std::vector<std::vector<GF2k<k>>> level;
+                for (std::size_t j = 0; j < below.size(); j += 2) {
+                    level.push_back(j + 1 < below.size() ? poly_mul(below[j], below[j + 1]) : below[j]);
+                }
+                m_levels.push_back(std::move(level));
+            }
+        }
+
+        std::size_t size() const { return m_levels[0].size(); }
+
+        /**
+         * The vanishing polynomial prod (x - x_i) of all points
+         */
+        const std::vector<GF2k<k>>& root() const { return m_levels.back()[0]; }
+
+        /**
+         * Evaluate `poly` in all points, by reducing it down the tree
+         */
+        std::vector<GF2k<k>> evaluate(const std::vector<GF2k<k>>& poly) const {
+            std::vector<std::vector<GF2k<k>>> rems{detail::poly_mod(poly, root())};
+            for (std::size_t l = m_levels.size() - 1; l-- > 0;) {
+                std::vector<std::vector<GF2k<k>>> next;
+                for (std::size_t j = 0; j < m_levels[l].size(); j++) next.push_back(detail::poly_mod(rems[j / 2], m_levels[l][j]));
+                rems = std::move(next);
+            }
+            std::vector<GF2k<k>> res;
+            res.reserve(size());
+            for (const auto& r : rems) res.push_back(r.empty() ? GF2k<k>(0) : r[0]);
+            return res;
+        }
+
+        /**
+         * For every point, 1 / prod_{m != i} (x_i - x_m), from evaluating the derivative of the root
+         */
+        std::vector<GF2k<k>> barycentric_weights() const {
+            const auto& m = root();
+            // In characteristic 2, only the odd degree terms survive in the derivative
+            std::vector<GF2k<k>> derivative(m.size() - 1, GF2k<k>(0));
+            for (std::size_t j = 1; j < m.size(); j += 2) derivative[j - 1] = m[j];
+            auto weights = evaluate(derivative);
+            batch::inv(weights);
+            return weights;
+        }
+
+        /**
+         * The coefficients of the polynomial of degree < size() through `ys`
+         */
+        std::vector<GF2k<k>> interpolate(const std::vector<GF2k<k>>& ys) const {
+            assert(ys.size() == size());
+            auto weights = barycentric_weights();
+            std::vector<std::vector<GF2k<k>>> combs;
+            for (std::size_t i = 0; i < size(); i++) combs.push_back({ys[i] * weights[i]});
+
+            // Going up: comb = comb_left * M_right + comb_right * M_left
+            for (std::size_t l = 0; l + 1 < m_levels.size(); l++) {
+                std::vector<std::vector<GF2k<k>>> next;
+                for (std::size_t j = 0; j < combs.size(); j += 2) {
+                    if (j + 1 == combs.size()) {
+                        next.push_back(std::move(combs[j]));
+                        continue;
+                    }
+                    auto left = poly_mul(combs[j], m_levels[l][j + 1]);
+                    auto right = poly_mul(combs[j + 1], m_levels[l][j]);
+                    if (left.size() < right.size()) std::swap(left, right);
+                    for (std::size_t i = 0; i < right.size(); i++) left[i] += right[i];
+                    next.push_back(std::move(left));
+                }
+                combs = std::move(next);
+            }
+            auto& res = combs[0];
+            res.resize(size(), GF2k<k>(0));
+            return res;
+        }
+
+    private:
+        std::vector<std::vector<std::vector<GF2k<k>>>> m_levels;
+};
@@ -0,0 +1,124 @@
+/*
+Copyright (c) 2022, COSIC-KU Leuven, Kasteelpark Arenberg 10, bus 2452, B-3001 Leuven-Heverlee, Belgium.
+
+All rights reserved
+*/
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of worker threads that split loops over an index range between them
+ *
+ * The calling thread takes part in every loop, so a pool of size 1 has no workers and runs everything inline.
+ */
+class ThreadPool {
+    public:
+        explicit ThreadPool(unsigned nthreads) : m_size(std::max(nthreads, 1u)) {
+            for (unsigned t = 1; t < m_size; t++) m_workers.emplace_back([this, t]() { work(t); });
+        }
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_start.notify_all();
+            for (auto& w : m_workers) w.join();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        unsigned size() const { return m_size; }
+
+        /**
+         * Call f(begin, end, thread) on consecutive chunks that cover [0, n), one per thread, and wait for all of them
+         * Chunks hold at least `min_chunk` indices, so small loops use fewer threads or just the calling one
+         */
+        void parallel_for(std::size_t n, const std::function<void(std::size_t, std::size_t, unsigned)>& f, std::size_t min_chunk = 1) {
+            unsigned used = static_cast<unsigned>(std::min<std::size_t>(m_size, n / std::max<std::size_t>(min_chunk, 1)));
+            if (used <= 1) {
+                if (n > 0) f(0, n, 0);
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_task = &f;
+                m_n = n;
+                m_used = used;
+                m_pending = used - 1;
+                m_generation++;
+            }
+            m_start.notify_all();
+            f(0, chunk_begin(0), 0);
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this]() { return m_pending == 0; });
+            m_task = nullptr;
+        }
+
+    private:
+        // Thread t handles [chunk_begin(t - 1), chunk_begin(t)), with chunk_begin(-1) == 0
+        std::size_t chunk_begin(unsigned t) const {
+            return m_n * (t + 1) / m_used;
+        }
+
+        void work(unsigned t) {
+            std::size_t seen = 0;
+            while (true) {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_start.wait(lock, [&]() { return m_stop || m_generation != seen; });
+                if (m_stop) return;
+                seen = m_generation;
+                if (t >= m_used) continue;
+                const auto* task = m_task;
+                std::size_t begin = chunk_begin(t - 1), end = chunk_begin(t);
+                lock.unlock();
+
+                (*task)(begin, end, t);
+
+                lock.lock();
+                if (--m_pending == 0) m_done.notify_one();
+            }
+        }
+
+        unsigned m_size;
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_start, m_done;
+        bool m_stop = false;
+        std::size_t m_generation = 0;
+        const std::function<void(std::size_t, std::size_t, unsigned)>* m_task = nullptr;
+        std::size_t m_n = 0;
+        unsigned m_used = 0;
+        unsigned m_pending = 0;
+};
+
+/**
+ * The number of threads to use: `arg` when given, otherwise the environment variable FETA_THREADS, otherwise 1
+ * Zero means all hardware threads
+ */
+inline unsigned thread_count(const char* arg = nullptr) {
+    const char* value = arg != nullptr ? arg : std::getenv("FETA_THREADS");
+    if (value == nullptr) return 1;
+
+    std::istringstream reader(value);
+    int requested = -1;
+    reader >> requested;
+    if (!reader || requested < 0) {
+        std::cerr << "Ignoring invalid thread count " << value << std::endl;
+        return 1;
+    }
+    if (requested == 0) return std::max(std::thread::hardware_concurrency(), 1u);
+    return requested;
+}
@@ -11,7 +11,9 @@ All rights reserved
 #include <iostream>
 #include <sstream>
 
+#include "additive_fft.h"
 #include "arith.h"
+#include "bitvector.h"
 #include "Circuit.h"
 #include "decoder.h"
 #include "io.h"
@@ -59,14 +61,15 @@ int main(int argc, char** argv) {
                     }
                 }
 
-                vector<ShareEl> A, B;
+                // The AND gate inputs as packed bits, only lifted when they're interpolated
+                BitVector A, B;
                 bool res = circ.eval_custom(wires,
                         [](bool a, bool b) -> bool {return a ^ b;},
                         [&A, &B, &preprocessing, &output](bool a, bool b) -> bool {
                             ShareEl mask = preprocessing.next();
                             output.next(mask - ShareEl(a & b));
-                            A.emplace_back(a);
-                            B.emplace_back(b);
+                            A.push_back(a);
+                            B.push_back(b);
                             return a && b;
                         },
                         [](bool a) -> bool {return !a;}
@@ -76,8 +79,8 @@ int main(int argc, char** argv) {
                 assert(res == 0);
 
                 int n1 = (A.size() + n2 - 1) / n2; // Rounding up
-                A.resize(n1 * n2, ShareEl(0)); // Extend the capacity with zeroes
-                B.resize(n1 * n2, ShareEl(0));
+                A.resize(n1 * n2); // Extend the capacity with zeroes
+                B.resize(n1 * n2);
 
                 // if using ρ full repetitions and σ SZ values, we need to add ρσ extra points for every interpolation
                 std::vector<ShareEl> ts(2 * n1 * FULL_REPETITIONS * SZ_REPETITIONS);
@@ -97,26 +100,51 @@ int main(int argc, char** argv) {
                     r = ShareEl::random(gen);
                 }
 
+                // The polynomials are interpolated in (0, ..., L-1) and evaluated in (n2, ..., 2L-1)
+                // When L is a power of two, both ranges are affine subspaces and the additive FFT does this in O(L log L)
+                const int L = n2 + SZ_REPETITIONS;
+                const bool use_fft = (L & (L - 1)) == 0;
+                const int log_L = AdditiveFFT<K>::log2_ceil(L);
+                const auto& fft = additive_fft<K>();
+                auto extend = [&](std::vector<ShareEl>& pts) {
+                    std::vector<ShareEl> upper(pts);
+                    fft.ifft(upper.data(), log_L);
+                    fft.fft(upper.data(), log_L, L);
+                    pts.insert(pts.end(), upper.begin(), upper.end());
+                };
+
                 std::vector<std::vector<ShareEl>> interpolation_preprocessing;
-                for (int i = 0; i < n2 + 2 * SZ_REPETITIONS; i++) {
-                    interpolation_preprocessing.emplace_back(interpolate_preprocess(n2 + SZ_REPETITIONS, ShareEl(n2 + i)));
+                if (!use_fft) {
+                    Barycentric<K> interp(L);
+                    for (int i = 0; i < n2 + 2 * SZ_REPETITIONS; i++) {
+                        interpolation_preprocessing.emplace_back(interp.coefficients(ShareEl(n2 + i)));
+                    }
                 }
                 for (int full = 0; full < FULL_REPETITIONS; full++) {
                     std::vector<ShareEl> ps(n2 + 2 * SZ_REPETITIONS, ShareEl(0));
                     for (int j = 0; j < n1; j++) {
-                        std::vector<ShareEl> ptsA(A.begin() + j * n2, A.begin() + (j + 1) * n2);
-                        for (auto& a : ptsA) {
-                            a *= rs[full * n1 + j];
+                        // r * a is either r or zero
+                        std::vector<ShareEl> ptsA, ptsB;
+                        for (int i = 0; i < n2; i++) {
+                            ptsA.push_back(A[j * n2 + i] ? rs[full * n1 + j] : ShareEl(0));
+                            ptsB.emplace_back(B[j * n2 + i]);
                         }
                         for (int k = 0; k < SZ_REPETITIONS; k++) {
                             ptsA.push_back(ts[full * 2 * n1 * SZ_REPETITIONS + j * 2 * SZ_REPETITIONS + k]);
                         }
-                        std::vector<ShareEl> ptsB(B.begin() + j * n2, B.begin() + (j + 1) * n2);
                         for (int k = 0; k < SZ_REPETITIONS; k++) {
                             ptsB.push_back(ts[full * 2 * n1 * SZ_REPETITIONS + (2*j + 1) * SZ_REPETITIONS + k]);
                         }
-                        for (int i = 0; i < n2 + 2 * SZ_REPETITIONS; i++) {
-                            ps[i] += interpolate_with_preprocessing(interpolation_preprocessing[i], ptsA) * interpolate_with_preprocessing(interpolation_preprocessing[i], ptsB);
+                        if (use_fft) {
+                            extend(ptsA);
+                            extend(ptsB);
+                            for (int i = 0; i < n2 + 2 * SZ_REPETITIONS; i++) {
+                                ps[i] += ptsA[n2 + i] * ptsB[n2 + i];
+                            }
+                        } else {
+                            for (int i = 0; i < n2 + 2 * SZ_REPETITIONS; i++) {
+                                ps[i] += interpolate_with_preprocessing(interpolation_preprocessing[i], ptsA) * interpolate_with_preprocessing(interpolation_preprocessing[i], ptsB);
+                            }
                         }
                     }
                     for (const auto& p : ps) {
@@ -15,6 +15,7 @@ All rights reserved
 #include "arith.h"
 #include "Circuit.h"
 #include "decoder.h"
+#include "gfvector.h"
 #include "io.h"
 #include "player.h"
 #include "random.h"
@@ -70,10 +71,12 @@ std::vector<ShareEl> verification(
         const std::vector<ShareEl>& ts,
         int n1, int n2,
         int full,
-        ShareEl zeta
+        ShareEl zeta,
+        const Barycentric<K>& interp_pts,
+        const Barycentric<K>& interp_ps
         ) {
-    std::vector<ShareEl> pre = interpolate_preprocess(n2 + SZ_REPETITIONS, zeta);
-    ShareEl P = interpolate(ps, zeta);
+    std::vector<ShareEl> pre = interp_pts.coefficients(zeta);
+    ShareEl P = interp_ps.evaluate(ps, zeta);
     std::vector<ShareEl> res;
     res.reserve(1 + 2 * n1);
     res.push_back(P);
@@ -97,36 +100,44 @@ std::vector<ShareEl> verification(
     return res;
 }
 
-bool open_all_and_check(std::vector<Data>&& all_shares_raw, int n1) {
-    std::vector<GFReader<K>> all_shares;
+bool open_all_and_check(Player& me, std::vector<Data>&& all_shares_raw, int n1) {
+    // Output wire o, followed by P and n1 times (A(zeta), B(zeta)) for every repetition
+    const std::size_t per_repetition = 1 + 2 * n1;
+    const std::size_t count = 1 + FULL_REPETITIONS * SZ_REPETITIONS * per_repetition;
+
+    // Column-major: all shares of a single party are contiguous
+    GFVector<K> shares(N * count);
     for (int i = 1; i <= N; i++) {
-        all_shares.emplace_back(std::make_shared<BufferBitReader>(std::move(all_shares_raw[i])));
+        if (me.is_cheater(i)) continue; // Nothing received, erased while decoding
+        GFReader<K> reader(std::make_shared<BufferBitReader>(std::move(all_shares_raw[i])));
+        for (std::size_t s = 0; s < count; s++) {
+            shares[(i - 1) * count + s] = reader.next();
+        }
     }
-    std::array<ShareEl, N> shares;
-    auto populate = [&shares, &all_shares]() { for (int j = 0; j < N; j++) shares[j] = all_shares[j].next(); };
 
-    populate();
-    auto [outwire_val, outwire_cheaters] = decode<T, T>(shares);
-    complain_cheaters(outwire_cheaters, "Opening of output wire o");
+    auto opened = decode_batch<T, T, N, K>(shares, me.cheaters());
+    for (const auto& [s, cheaters] : opened.cheaters) {
+        if (s == 0) {
+            me.blacklist(cheaters, "Opening of output wire o");
+        } else if ((s - 1) % per_repetition == 0) {
+            me.blacklist(cheaters, "Opening of P");
+        } else if ((s - 1) % per_repetition % 2 == 1) {
+            me.blacklist(cheaters, "Opening of an A(zeta)");
+        } else {
+            me.blacklist(cheaters, "Opening of a B(zeta)");
+        }
+    }
 
-    bool okay = outwire_val[0] == ShareEl{0};
+    bool okay = opened.secrets[0] == ShareEl{0};
 
+    // Schwartz-Zippel: every opened P must be the sum of the opened A(zeta) * B(zeta) of its repetition
     for (int i = 0; i < FULL_REPETITIONS * SZ_REPETITIONS; i++) {
-        std::array<ShareEl, N> shares;
-        populate();
-        auto [P_val, P_cheaters] = decode<T, T>(shares);
-        complain_cheaters(P_cheaters, "Opening of P");
+        std::size_t offset = 1 + i * per_repetition;
         ShareEl AB_verif{0};
         for (int j = 0; j < n1; j++) {
-            populate();
-            auto [A_val, A_cheaters] = decode<T, T>(shares);
-            complain_cheaters(A_cheaters, "Opening of an A(zeta)");
-            populate();
-            auto [B_val, B_cheaters] = decode<T, T>(shares);
-            complain_cheaters(B_cheaters, "Opening of a B(zeta)");
-            AB_verif += A_val[0] * B_val[0];
+            AB_verif += opened.secrets[offset + 1 + 2 * j] * opened.secrets[offset + 2 + 2 * j];
         }
-        okay = okay && (P_val[0] == AB_verif);
+        okay = okay && (opened.secrets[offset] == AB_verif);
     }
     return okay;
 }
@@ -205,10 +216,13 @@ int main(int argc, char** argv) {
                 auto to_open = GFWriter<K>(to_open_writer);
                 to_open.next(o_share);
 
+                // The polynomials for A and B go through n2 + SZ_REPETITIONS points, their products through twice as many
+                Barycentric<K> interp_pts(n2 + SZ_REPETITIONS);
+                Barycentric<K> interp_ps(2 * (n2 + SZ_REPETITIONS));
                 for (int full = 0; full < FULL_REPETITIONS; full++) {
                     std::vector<ShareEl> ps = get_P(C, rs, proof_2, preprocessing, n1, n2, full);
                     for (int z = 0; z < SZ_REPETITIONS; z++) {
-                        for (ShareEl pt : verification(A, B, ps, rs, ts, n1, n2, full, zetas[full * SZ_REPETITIONS + z])) {
+                        for (ShareEl pt : verification(A, B, ps, rs, ts, n1, n2, full, zetas[full * SZ_REPETITIONS + z], interp_pts, interp_ps)) {
                             to_open.next(pt);
                         }
                     }
@@ -217,7 +231,7 @@ int main(int argc, char** argv) {
                 me.send_all(my_shares, 0);
                 std::vector<Data> all_shares = me.recv_from_all(0); // `FULL_REPETITIONS * SZ_REPETITIONS * (2*n1) * K` should be small enough to avoid deadlocks for now; TODO
                 all_shares[me.player_idx] = std::move(my_shares);
-                return open_all_and_check(std::move(all_shares), n1);
+                return open_all_and_check(me, std::move(all_shares), n1);
             },
 
             [](bool success, double time_taken, int nruns) {
@@ -75,7 +75,12 @@ bool validate(Player& me, const std::vector<ShareEl>& my_shares) {
     std::vector<Data> all_shares_raw = me.recv_from_all(0);
     std::vector<std::array<ShareEl, N>> all_shares(1 + REPETITIONS);
     for (int p = 1; p <= N; p++) {
-        if (p == me.player_idx) {
+        if (me.is_cheater(p)) {
+            // Blacklisted earlier: nothing was received, the shares are erased while decoding
+            for (int i = 0; i < 1 + REPETITIONS; i++) {
+                all_shares[i][p - 1] = ShareEl(0);
+            }
+        } else if (p == me.player_idx) {
             for (int i = 0; i < 1 + REPETITIONS; i++) {
                 all_shares[i][p - 1] = my_shares[i];
             }
@@ -87,8 +92,8 @@ bool validate(Player& me, const std::vector<ShareEl>& my_shares) {
         }
     }
 
-    auto [circ_out, circ_out_cheaters] = decode<T, T>(all_shares[0]);
-    complain_cheaters(circ_out_cheaters, "output reconstruction");
+    auto [circ_out, circ_out_cheaters] = decode<T, T>(all_shares[0], me.cheaters());
+    me.blacklist(circ_out_cheaters, "output reconstruction");
 
     if (circ_out[0] != ShareEl(0)) {
         std::cout << "Circuit output wasn't 0, invalid proof" << std::endl;
@@ -96,8 +101,8 @@ bool validate(Player& me, const std::vector<ShareEl>& my_shares) {
     }
 
     for (int j = 0; j < REPETITIONS; j++) {
-        auto [AmC, AmC_cheaters] = decode<2*T, T>(all_shares[j + 1]);
-        complain_cheaters(AmC_cheaters, "reconstruction of (A - C)");
+        auto [AmC, AmC_cheaters] = decode<2*T, T>(all_shares[j + 1], me.cheaters());
+        me.blacklist(AmC_cheaters, "reconstruction of (A - C)");
         if (AmC[0] != ShareEl(0)) {
             std::cout << "Multiplications are inconsistent; invalid proof" << std::endl;
             return false;